@@ -1,33 +1,36 @@
 #include "3Dplotter.hpp"
+#include "Statistics.hpp"
+#include "Coords.hpp"
 #include <cmath>
 #include <numbers>
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
 
-// --- Koordinat Dönüşüm ve Yardımcı Fonksiyonlar ---
-namespace Coords {
-    constexpr double A = 6378137.0;
-    constexpr double E_SQ = 0.00669437999014;
-
-    auto deg2rad(double d) { return d * std::numbers::pi / 180.0; };
-    auto rad2deg(double r) { return r * 180.0 / std::numbers::pi; };
-
-    DataPoint lla_to_ecef(double lat_deg, double lon_deg, double alt_m) {
-        double lat_rad = deg2rad(lat_deg);
-        double lon_rad = deg2rad(lon_deg);
-        double N = A / std::sqrt(1.0 - E_SQ * std::sin(lat_rad) * std::sin(lat_rad));
+// --- Veri İşleme Fonksiyonları ---
 
-        return {
-            (N + alt_m) * std::cos(lat_rad) * std::cos(lon_rad),
-            (N + alt_m) * std::cos(lat_rad) * std::sin(lon_rad),
-            (N * (1.0 - E_SQ) + alt_m) * std::sin(lat_rad)
-        };
-    }
+// process_truth_data/process_radar_data dönüşümü değiştiğinde artırılır (istatistik önbelleğini geçersiz kılar)
+constexpr uint32_t stats_processing_version = 1;
+
+// Menzil/Yanca/Yükseliş yalnızca kullanıcı istediğinde hesaplanır
+static void add_sensor_relative_columns(SearchableDataset& ds_out, const DataPoint& sensor_ecef) {
+    ds_out.derived_columns.push_back({ "range", [sensor_ecef](const SearchableDataset& ds, size_t i) {
+        double dx = ds.x_data[i] - sensor_ecef.x;
+        double dy = ds.y_data[i] - sensor_ecef.y;
+        double dz = ds.z_data[i] - sensor_ecef.z;
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    } });
+    ds_out.derived_columns.push_back({ "bearing", [sensor_ecef](const SearchableDataset& ds, size_t i) {
+        return Coords::rad2deg(std::atan2(ds.y_data[i] - sensor_ecef.y, ds.x_data[i] - sensor_ecef.x));
+    } });
+    ds_out.derived_columns.push_back({ "elevation", [sensor_ecef](const SearchableDataset& ds, size_t i) {
+        double dx = ds.x_data[i] - sensor_ecef.x;
+        double dy = ds.y_data[i] - sensor_ecef.y;
+        double dz = ds.z_data[i] - sensor_ecef.z;
+        return Coords::rad2deg(std::asin(dz / std::sqrt(dx * dx + dy * dy + dz * dz)));
+    } });
 }
 
-// --- Veri İşleme Fonksiyonları ---
-
 SearchableDataset process_truth_data(const SearchableDataset& raw_data, const DataPoint& origin_lla, const DataPoint& radar_pos_ecef) {
     SearchableDataset processed = raw_data;
     processed.has_rbe_capability = true;
@@ -38,8 +41,6 @@ SearchableDataset process_truth_data(const SearchableDataset& raw_data, const Da
     processed.bearing_data.clear();
     processed.elevation_data.clear();
 
-    double lat_rad = Coords::deg2rad(origin_lla.x);
-    double lon_rad = Coords::deg2rad(origin_lla.y);
     const DataPoint origin_ecef = Coords::lla_to_ecef(origin_lla.x, origin_lla.y, origin_lla.z);
 
     for (size_t i = 0; i < raw_data.x_data.size(); ++i) {
@@ -47,14 +48,7 @@ SearchableDataset process_truth_data(const SearchableDataset& raw_data, const Da
         double e = raw_data.y_data[i];
         double d = -raw_data.z_data[i];
 
-        double clat = cos(lat_rad), slat = sin(lat_rad);
-        double clon = cos(lon_rad), slon = sin(lon_rad);
-
-        DataPoint ecef_offset = {
-            -slat * clon * n - slon * e - clat * clon * d,
-            -slat * slon * n + clon * e - clat * slon * d,
-             clat * n - slat * d
-        };
+        DataPoint ecef_offset = Coords::ned_to_ecef_offset(origin_lla, n, e, d);
 
         DataPoint target_absolute = { origin_ecef.x + ecef_offset.x, origin_ecef.y + ecef_offset.y, origin_ecef.z + ecef_offset.z };
 
@@ -67,15 +61,9 @@ SearchableDataset process_truth_data(const SearchableDataset& raw_data, const Da
             target_absolute.y - origin_ecef.y,
             target_absolute.z - origin_ecef.z
             });
-
-        double dx = target_absolute.x - radar_pos_ecef.x;
-        double dy = target_absolute.y - radar_pos_ecef.y;
-        double dz = target_absolute.z - radar_pos_ecef.z;
-        double range = std::sqrt(dx * dx + dy * dy + dz * dz);
-        processed.range_data.push_back(range);
-        processed.bearing_data.push_back(Coords::rad2deg(std::atan2(dy, dx)));
-        processed.elevation_data.push_back(Coords::rad2deg(std::asin(dz / range)));
     }
+
+    add_sensor_relative_columns(processed, radar_pos_ecef);
     return processed;
 }
 
@@ -84,6 +72,8 @@ SearchableDataset process_radar_data(const MuaseretScenarioOutput& muaseret_inpu
     processed.name = "Radar Olcumleri";
     processed.is_line_series = false;
     processed.has_rbe_capability = true;
+    processed.sensor_lla = origin_lla;
+    processed.sensor_ecef = radar_pos_ecef;
     processed.fields.push_back({ "Zaman (s)",  [&ds = processed](size_t i) { return ds.time_data[i]; } });
 
     const DataPoint origin_ecef = Coords::lla_to_ecef(origin_lla.x, origin_lla.y, origin_lla.z);
@@ -97,27 +87,7 @@ SearchableDataset process_radar_data(const MuaseretScenarioOutput& muaseret_inpu
         processed.bearing_data.push_back(radar_meas.bearing);
         processed.elevation_data.push_back(radar_meas.elevation);
 
-        double r = radar_meas.range;
-        double b_rad = Coords::deg2rad(radar_meas.bearing);
-        double e_rad = Coords::deg2rad(radar_meas.elevation);
-
-        double e_local = r * cos(e_rad) * sin(b_rad);
-        double n_local = r * cos(e_rad) * cos(b_rad);
-        double u_local = r * sin(e_rad);
-        double d_local = -u_local;
-
-        double lat_rad = Coords::deg2rad(origin_lla.x);
-        double lon_rad = Coords::deg2rad(origin_lla.y);
-        double clat = cos(lat_rad), slat = sin(lat_rad);
-        double clon = cos(lon_rad), slon = sin(lon_rad);
-
-        DataPoint ecef_offset = {
-            -slat * clon * n_local - slon * e_local - clat * clon * d_local,
-            -slat * slon * n_local + clon * e_local - clat * slon * d_local,
-             clat * n_local - slat * d_local
-        };
-
-        DataPoint target_absolute = { radar_pos_ecef.x + ecef_offset.x, radar_pos_ecef.y + ecef_offset.y, radar_pos_ecef.z + ecef_offset.z };
+        DataPoint target_absolute = Coords::rbe_to_ecef(origin_lla, radar_pos_ecef, radar_meas.range, radar_meas.bearing, radar_meas.elevation);
 
         processed.x_data.push_back(target_absolute.x);
         processed.y_data.push_back(target_absolute.y);
@@ -162,6 +132,46 @@ void plot3D(const SearchableDataset& gercek_yorunge_data, const MuaseretScenario
         datasets_to_plot.push_back(radar_processed);
     }
 
-    launchInteractivePlotter(datasets_to_plot, radar_pos_relative);
+    // Sütun istatistikleri (kayıt yanındaki önbellekten veya tek paralel geçişle). Önbellek anahtarı,
+    // istatistiklerin hesaplandığı dönüştürülmüş verinin girdilerini (orijin ve radar konumu) içerir.
+    // Yalnızca diskten okunan gerçek yörünge önbelleklenir; radar ölçümleri her çalıştırmada yeni gürültüyle
+    // üretildiğinden source_path taşımaz.
+    const uint64_t processing_key = statisticsProcessingKey(stats_processing_version,
+        { origin_lla.x, origin_lla.y, origin_lla.z, radar_pos_lla.x, radar_pos_lla.y, radar_pos_lla.z });
+    for (auto& ds : datasets_to_plot) {
+        loadOrComputeStatistics(ds, processing_key);
+    }
+
+    launchInteractivePlotter(std::move(datasets_to_plot), radar_pos_relative);
+}
+
+void plotLive(uint16_t udp_port, const std::string& follow_path) {
+    const DataPoint radar_pos_lla = { 39.90, 32.80, 1000 };
+    const DataPoint radar_pos_ecef = Coords::lla_to_ecef(radar_pos_lla.x, radar_pos_lla.y, radar_pos_lla.z);
+
+    // Orijin radarın kendisidir, radarın çizim konumu sıfırdır
+    LiveConfig live;
+    live.udp_port = udp_port;
+    live.follow_path = follow_path;
+    live.follow_stream = 0;
+    live.origin_lla = radar_pos_lla;
+    live.origin_ecef = radar_pos_ecef;
+    live.sensor_lla = radar_pos_lla;
+    live.sensor_ecef = radar_pos_ecef;
+    live.stream_datasets = { 0, 1 };
+
+    std::vector<SearchableDataset> datasets(2);
+    datasets[0].name = "Canli Gercek Yorunge";
+    datasets[0].is_line_series = true;
+    datasets[0].has_rbe_capability = true;
+    add_sensor_relative_columns(datasets[0], radar_pos_ecef);
+
+    datasets[1].name = "Canli Radar Olcumleri";
+    datasets[1].has_rbe_capability = true;
+    datasets[1].sensor_lla = radar_pos_lla;
+    datasets[1].sensor_ecef = radar_pos_ecef;
+    add_sensor_relative_columns(datasets[1], radar_pos_ecef);
+
+    launchInteractivePlotter(std::move(datasets), { 0, 0, 0 }, live);
 }
 
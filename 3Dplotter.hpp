@@ -8,4 +8,9 @@
 // Veriyi işleyen ve 3D çizdiriciyi başlatan ana fonksiyon.
 void plot3D(const SearchableDataset& gercek_yorunge_data, const MuaseretScenarioOutput& muaseret_input);
 
+// Boş bir gerçek yörünge ve radar ölçümü veri setiyle açılır; veriler localhost UDP üzerinden canlı gelir
+// (akış 0: gerçek yörünge, akış 1: radar ölçümleri; bkz. LiveIngest.hpp). follow_path verilirse büyümekte olan
+// senaryo kaydı izlenir ve satırları gerçek yörüngeye eklenir. udp_port 0 ise UDP dinlenmez.
+void plotLive(uint16_t udp_port, const std::string& follow_path = "");
+
 #endif // PLOTTER_3D_HPP
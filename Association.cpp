@@ -0,0 +1,129 @@
+#include "Association.hpp"
+#include "Statistics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <string>
+
+namespace {
+    struct TruthSample {
+        DataPoint point;
+        DataPoint ecef;
+    };
+
+    // Gerçek yörüngeyi verilen zamanda doğrusal enterpole eder. Zaman kapsam dışındaysa false döner.
+    bool interpolate_truth(const SearchableDataset& truth, double time, TruthSample& out) {
+        const auto& t = truth.time_data;
+        if (t.empty() || time < t.front() || time > t.back()) return false;
+        size_t idx1 = std::distance(t.begin(), std::lower_bound(t.begin(), t.end(), time));
+        if (idx1 == 0) idx1 = std::min<size_t>(1, t.size() - 1);
+        size_t idx0 = idx1 > 0 ? idx1 - 1 : 0;
+        double dt = t[idx1] - t[idx0];
+        double f = dt > 1e-9 ? (time - t[idx0]) / dt : 0.0;
+
+        auto lerp = [f](double a, double b) { return a + (b - a) * f; };
+        const auto& p0 = truth.points[idx0];
+        const auto& p1 = truth.points[idx1];
+        out.point = { lerp(p0.x, p1.x), lerp(p0.y, p1.y), lerp(p0.z, p1.z) };
+        out.ecef = {
+            lerp(truth.x_data[idx0], truth.x_data[idx1]),
+            lerp(truth.y_data[idx0], truth.y_data[idx1]),
+            lerp(truth.z_data[idx0], truth.z_data[idx1])
+        };
+        return true;
+    }
+
+    // Bir ECEF konumunun sensöre göre menzil/yanca/yükseliş değerleri (yerel NED çerçevesinde, derece).
+    DataPoint ecef_to_rbe(const DataPoint& ecef, const DataPoint& sensor_ecef, const DataPoint& sensor_lla) {
+        double lat_rad = sensor_lla.x * std::numbers::pi / 180.0;
+        double lon_rad = sensor_lla.y * std::numbers::pi / 180.0;
+        double clat = cos(lat_rad), slat = sin(lat_rad);
+        double clon = cos(lon_rad), slon = sin(lon_rad);
+
+        double dx = ecef.x - sensor_ecef.x;
+        double dy = ecef.y - sensor_ecef.y;
+        double dz = ecef.z - sensor_ecef.z;
+        double n = -slat * clon * dx - slat * slon * dy + clat * dz;
+        double e = -slon * dx + clon * dy;
+        double d = -clat * clon * dx - clat * slon * dy - slat * dz;
+
+        double range = std::sqrt(n * n + e * e + d * d);
+        double bearing = std::atan2(e, n) * 180.0 / std::numbers::pi;
+        double elevation = std::atan2(-d, std::sqrt(n * n + e * e)) * 180.0 / std::numbers::pi;
+        return { range, bearing, elevation };
+    }
+
+    double wrap_deg(double angle) {
+        angle = std::fmod(angle + 180.0, 360.0);
+        if (angle < 0) angle += 360.0;
+        return angle - 180.0;
+    }
+}
+
+bool is_truth_dataset(const SearchableDataset& ds) {
+    return ds.name.find("Gercek") != std::string::npos;
+}
+
+std::vector<AssociationTable> buildAssociationTables(const std::vector<SearchableDataset>& datasets) {
+    std::vector<AssociationTable> tables(datasets.size());
+
+    std::vector<size_t> truth_indices;
+    for (size_t i = 0; i < datasets.size(); ++i) {
+        if (is_truth_dataset(datasets[i]) && datasets[i].points.size() > 1) truth_indices.push_back(i);
+    }
+    if (truth_indices.empty()) return tables;
+
+    for (size_t m = 0; m < datasets.size(); ++m) {
+        const auto& ds = datasets[m];
+        if (is_truth_dataset(ds) || ds.time_data.empty()) continue;
+
+        auto& table = tables[m];
+        const size_t n = ds.time_data.size();
+        table.truth_dataset_idx.assign(n, AssociationTable::no_truth);
+        table.truth_points.assign(n, { 0, 0, 0 });
+        table.truth_ecef.assign(n, { 0, 0, 0 });
+        table.residual_ecef.assign(n, { NAN, NAN, NAN });
+        table.has_rbe = ds.has_rbe_capability && ds.range_data.size() == n;
+        if (table.has_rbe) table.residual_rbe.assign(n, { NAN, NAN, NAN });
+
+        for (size_t i = 0; i < n; ++i) {
+            const DataPoint meas = { ds.x_data[i], ds.y_data[i], ds.z_data[i] };
+            double best_dist_sq = std::numeric_limits<double>::max();
+            for (size_t truth_idx : truth_indices) {
+                TruthSample sample;
+                if (!interpolate_truth(datasets[truth_idx], ds.time_data[i], sample)) continue;
+                DataPoint residual = { meas.x - sample.ecef.x, meas.y - sample.ecef.y, meas.z - sample.ecef.z };
+                double dist_sq = residual.x * residual.x + residual.y * residual.y + residual.z * residual.z;
+                if (dist_sq < best_dist_sq) {
+                    best_dist_sq = dist_sq;
+                    table.truth_dataset_idx[i] = (uint32_t)truth_idx;
+                    table.truth_points[i] = sample.point;
+                    table.truth_ecef[i] = sample.ecef;
+                    table.residual_ecef[i] = residual;
+                }
+            }
+            if (table.has_rbe && table.truth_dataset_idx[i] != AssociationTable::no_truth) {
+                DataPoint truth_rbe = ecef_to_rbe(table.truth_ecef[i], ds.sensor_ecef, ds.sensor_lla);
+                table.residual_rbe[i] = {
+                    ds.range_data[i] - truth_rbe.x,
+                    wrap_deg(ds.bearing_data[i] - truth_rbe.y),
+                    ds.elevation_data[i] - truth_rbe.z
+                };
+            }
+        }
+
+        const size_t stride = sizeof(DataPoint) / sizeof(double);
+        std::vector<ColumnView> columns = {
+            { "err_x", &table.residual_ecef[0].x, n, stride },
+            { "err_y", &table.residual_ecef[0].y, n, stride },
+            { "err_z", &table.residual_ecef[0].z, n, stride },
+        };
+        if (table.has_rbe) {
+            columns.push_back({ "err_range", &table.residual_rbe[0].x, n, stride });
+            columns.push_back({ "err_bearing", &table.residual_rbe[0].y, n, stride });
+            columns.push_back({ "err_elevation", &table.residual_rbe[0].z, n, stride });
+        }
+        table.residual_stats = computeColumnStatistics(columns);
+    }
+    return tables;
+}
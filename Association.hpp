@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include "DataStructures.hpp"
+
+// Bir ölçüm veri setinin her noktasını, aynı andaki (enterpole edilmiş) gerçek yörünge konumuyla eşleştiren tablo.
+// Yükleme sırasında bir kez kurulur; çizim ve istatistik kodu her kare arama yapmak yerine buradan okur.
+struct AssociationTable {
+    static constexpr uint32_t no_truth = std::numeric_limits<uint32_t>::max();
+
+    std::vector<uint32_t> truth_dataset_idx; // Eşleşen gerçek veri seti, yoksa no_truth
+    std::vector<DataPoint> truth_points;     // Gerçek konum, çizim (orijine göreli) koordinatlarında
+    std::vector<DataPoint> truth_ecef;       // Gerçek konum, mutlak ECEF
+    std::vector<DataPoint> residual_ecef;    // Ölçüm - gerçek (m), eşleşme yoksa NaN
+    std::vector<DataPoint> residual_rbe;     // Ölçüm - gerçek: menzil (m), yanca (deg), yükseliş (deg)
+    bool has_rbe = false;
+
+    // Artık sütunlarının istatistikleri: err_x, err_y, err_z ve (varsa) err_range, err_bearing, err_elevation
+    std::vector<ColumnStats> residual_stats;
+
+    bool empty() const { return truth_dataset_idx.empty(); }
+    bool is_valid(size_t i) const { return i < truth_dataset_idx.size() && truth_dataset_idx[i] != no_truth; }
+};
+
+// Gerçek yörünge veri setlerini isimlerinden tanır.
+bool is_truth_dataset(const SearchableDataset& ds);
+
+// Gerçek olmayan her veri seti için eşleşme tablosu kurar (gerçek veri setleri için tablo boş kalır).
+// Birden fazla gerçek yörünge varsa ölçüm, o anda kendisine en yakın olana atanır.
+std::vector<AssociationTable> buildAssociationTables(const std::vector<SearchableDataset>& datasets);
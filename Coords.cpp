@@ -0,0 +1,45 @@
+#include "Coords.hpp"
+#include <cmath>
+#include <numbers>
+
+namespace Coords {
+    double deg2rad(double d) { return d * std::numbers::pi / 180.0; }
+    double rad2deg(double r) { return r * 180.0 / std::numbers::pi; }
+
+    DataPoint lla_to_ecef(double lat_deg, double lon_deg, double alt_m) {
+        double lat_rad = deg2rad(lat_deg);
+        double lon_rad = deg2rad(lon_deg);
+        double N = A / std::sqrt(1.0 - E_SQ * std::sin(lat_rad) * std::sin(lat_rad));
+
+        return {
+            (N + alt_m) * std::cos(lat_rad) * std::cos(lon_rad),
+            (N + alt_m) * std::cos(lat_rad) * std::sin(lon_rad),
+            (N * (1.0 - E_SQ) + alt_m) * std::sin(lat_rad)
+        };
+    }
+
+    DataPoint ned_to_ecef_offset(const DataPoint& origin_lla, double n, double e, double d) {
+        double lat_rad = deg2rad(origin_lla.x);
+        double lon_rad = deg2rad(origin_lla.y);
+        double clat = cos(lat_rad), slat = sin(lat_rad);
+        double clon = cos(lon_rad), slon = sin(lon_rad);
+
+        return {
+            -slat * clon * n - slon * e - clat * clon * d,
+            -slat * slon * n + clon * e - clat * slon * d,
+             clat * n - slat * d
+        };
+    }
+
+    DataPoint rbe_to_ecef(const DataPoint& sensor_lla, const DataPoint& sensor_ecef, double range, double bearing_deg, double elevation_deg) {
+        double b_rad = deg2rad(bearing_deg);
+        double e_rad = deg2rad(elevation_deg);
+
+        double e_local = range * cos(e_rad) * sin(b_rad);
+        double n_local = range * cos(e_rad) * cos(b_rad);
+        double u_local = range * sin(e_rad);
+
+        DataPoint ecef_offset = ned_to_ecef_offset(sensor_lla, n_local, e_local, -u_local);
+        return { sensor_ecef.x + ecef_offset.x, sensor_ecef.y + ecef_offset.y, sensor_ecef.z + ecef_offset.z };
+    }
+}
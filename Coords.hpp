@@ -0,0 +1,21 @@
+#pragma once
+
+#include "DataStructures.hpp"
+
+// --- Koordinat Dönüşüm Yardımcıları ---
+// LLA noktaları { enlem (deg), boylam (deg), irtifa (m) } olarak DataPoint içinde tutulur.
+namespace Coords {
+    constexpr double A = 6378137.0;
+    constexpr double E_SQ = 0.00669437999014;
+
+    double deg2rad(double d);
+    double rad2deg(double r);
+
+    DataPoint lla_to_ecef(double lat_deg, double lon_deg, double alt_m);
+
+    // origin_lla'daki yerel Kuzey-Doğu-Aşağı ötelemesinin ECEF karşılığı
+    DataPoint ned_to_ecef_offset(const DataPoint& origin_lla, double n, double e, double d);
+
+    // Sensöre göre menzil (m), yanca (deg) ve yükseliş (deg) ölçümünün mutlak ECEF konumu
+    DataPoint rbe_to_ecef(const DataPoint& sensor_lla, const DataPoint& sensor_ecef, double range, double bearing_deg, double elevation_deg);
+}
@@ -13,6 +13,7 @@
 #include "coordinatedTurn.hpp"
 #include <vector>
 #include <fstream>
+#include <sstream>
 #include <stdexcept>
 #include <iomanip>
 
@@ -72,7 +73,48 @@ SearchableDataset createAndSaveSimpleScenario(const std::string& output_csv_file
             << states[i].z << "," << states[i].vz << ",0,0\n";
     }
     outfile.close();
+    // Dosya her çalıştırmada yeniden üretildiğinden source_path verilmez: istatistik önbelleği hiç tutmaz,
+    // yalnızca gereksiz yan dosya yazardı. Önbellek, diskten okunan kayıtlar içindir (bkz. loadSimpleScenario).
 
     return scenario_dataset;
 }
 
+SearchableDataset loadSimpleScenario(const std::string& csv_filename) {
+    std::ifstream infile(csv_filename);
+    if (!infile.is_open()) {
+        throw std::runtime_error("CSV dosyasi okunamadi: " + csv_filename);
+    }
+
+    SearchableDataset scenario_dataset;
+    scenario_dataset.name = "Gercek Yorunge";
+    scenario_dataset.is_line_series = true;
+    scenario_dataset.source_path = csv_filename;
+
+    // Sütunlar: time,posX,velX,accelX,posY,velY,accelY,posZ,velZ,accelZ,someValue
+    std::string line;
+    std::getline(infile, line); // Başlık satırını atla
+    while (std::getline(infile, line)) {
+        if (line.empty()) continue;
+        std::stringstream ss(line);
+        std::string cell;
+        double values[8];
+        for (double& value : values) {
+            std::getline(ss, cell, ',');
+            value = std::stod(cell);
+        }
+        scenario_dataset.time_data.push_back(values[0]);
+        scenario_dataset.x_data.push_back(values[1]);
+        scenario_dataset.y_data.push_back(values[4]);
+        scenario_dataset.z_data.push_back(values[7]);
+        scenario_dataset.points.push_back({ values[1], values[4], values[7] });
+    }
+    if (scenario_dataset.time_data.empty()) {
+        throw std::runtime_error("Senaryo dosyasi bos: " + csv_filename);
+    }
+    scenario_dataset.fields.push_back({ "Zaman (s)", [&ds = scenario_dataset](size_t i) { return ds.time_data[i]; } });
+    scenario_dataset.fields.push_back({ "X (m)",     [&ds = scenario_dataset](size_t i) { return ds.x_data[i]; } });
+    scenario_dataset.fields.push_back({ "Y (m)",     [&ds = scenario_dataset](size_t i) { return ds.y_data[i]; } });
+    scenario_dataset.fields.push_back({ "Z (m)",     [&ds = scenario_dataset](size_t i) { return ds.z_data[i]; } });
+    return scenario_dataset;
+}
+
@@ -17,5 +17,9 @@
 
 SearchableDataset createAndSaveSimpleScenario(const std::string& output_csv_filename);
 
+// Daha önce kaydedilmiş bir senaryo CSV dosyasını gerçek yörünge veri seti olarak okur. Kayıt kalıcı olduğundan
+// source_path verilir; sütun istatistikleri kaydın yanındaki önbellekten okunabilir.
+SearchableDataset loadSimpleScenario(const std::string& csv_filename);
+
 #endif // CREATE_SIMPLE_SCENARIO_HPP
 
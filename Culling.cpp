@@ -0,0 +1,88 @@
+#include "Culling.hpp"
+#include <algorithm>
+#include <cmath>
+
+void Aabb::extend(const Math::Vec3& p) {
+    min.x = std::min(min.x, p.x); min.y = std::min(min.y, p.y); min.z = std::min(min.z, p.z);
+    max.x = std::max(max.x, p.x); max.y = std::max(max.y, p.y); max.z = std::max(max.z, p.z);
+}
+
+Frustum extractFrustum(const Math::Mat4& view_proj) {
+    // Matris sütun öncelikli: i. satır (m[i], m[4+i], m[8+i], m[12+i])
+    // Düzlemler: 4. satır ± 1., 2., 3. satırlar
+    auto plane = [&](float* out, int row, float sign) {
+        for (int c = 0; c < 4; ++c) {
+            out[c] = view_proj.m[c * 4 + 3] + sign * view_proj.m[c * 4 + row];
+        }
+    };
+    Frustum f;
+    plane(f.planes[0], 0, 1.0f);  // Sol
+    plane(f.planes[1], 0, -1.0f); // Sağ
+    plane(f.planes[2], 1, 1.0f);  // Alt
+    plane(f.planes[3], 1, -1.0f); // Üst
+    plane(f.planes[4], 2, 1.0f);  // Yakın
+    plane(f.planes[5], 2, -1.0f); // Uzak
+    for (auto& p : f.planes) {
+        float len = sqrtf(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        if (len > 0.0f) {
+            for (float& v : p) v /= len;
+        }
+    }
+    return f;
+}
+
+bool Frustum::intersects(const Aabb& box) const {
+    if (box.empty()) return false;
+    for (const auto& p : planes) {
+        // Kutunun düzlem normali yönündeki en uç köşesi bile dışarıdaysa kutu tamamen dışarıdadır
+        float x = p[0] >= 0.0f ? box.max.x : box.min.x;
+        float y = p[1] >= 0.0f ? box.max.y : box.min.y;
+        float z = p[2] >= 0.0f ? box.max.z : box.min.z;
+        if (p[0] * x + p[1] * y + p[2] * z + p[3] < 0.0f) return false;
+    }
+    return true;
+}
+
+void PointChunks::append(const std::vector<DataPoint>& points, const std::vector<double>& times) {
+    size_t new_count = points.size();
+    if (new_count <= point_count) return;
+    // Son parça yarımsa baştan hesaplanır
+    size_t first_chunk = point_count / chunk_size;
+    bounds.resize((new_count + chunk_size - 1) / chunk_size);
+    const bool has_time = times.size() >= new_count;
+    for (size_t c = first_chunk; c < bounds.size(); ++c) {
+        ChunkBounds b;
+        if (has_time) {
+            b.t_min = std::numeric_limits<float>::max();
+            b.t_max = -std::numeric_limits<float>::max();
+        }
+        size_t end = std::min(new_count, (c + 1) * chunk_size);
+        for (size_t i = c * chunk_size; i < end; ++i) {
+            const auto& p = points[i];
+            b.box.extend({ (float)p.x, (float)p.z, (float)-p.y });
+            if (has_time) {
+                b.t_min = std::min(b.t_min, (float)times[i]);
+                b.t_max = std::max(b.t_max, (float)times[i]);
+            }
+        }
+        bounds[c] = b;
+    }
+    point_count = new_count;
+}
+
+void PointChunks::select_ranges(const Frustum& frustum, float t_start, float t_end, size_t limit,
+    std::vector<int>& firsts, std::vector<int>& counts) const {
+    size_t end = std::min(limit, point_count);
+    for (size_t c = 0; c < bounds.size() && c * chunk_size < end; ++c) {
+        if (!bounds[c].visible(frustum, t_start, t_end)) continue;
+        int first = (int)(c * chunk_size);
+        int count = (int)(std::min(end, (c + 1) * chunk_size) - c * chunk_size);
+        if (!firsts.empty() && firsts.back() + counts.back() == first) {
+            counts.back() += count;
+        }
+        else {
+            firsts.push_back(first);
+            counts.push_back(count);
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include "DataStructures.hpp"
+#include "Math.hpp"
+
+// Eksen hizalı sınırlayıcı kutu (OpenGL koordinatları).
+struct Aabb {
+    Math::Vec3 min = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+    Math::Vec3 max = { -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+
+    void extend(const Math::Vec3& p);
+    bool empty() const { return min.x > max.x; }
+};
+
+// view * projection matrisinden çıkarılan altı kırpma düzlemi (Gribb-Hartmann). Düzlem normalleri içeri bakar.
+struct Frustum {
+    float planes[6][4] = {};
+
+    // Kutu tamamen bir düzlemin dışındaysa false döner (muhafazakâr test, yanlış pozitif olabilir).
+    bool intersects(const Aabb& box) const;
+};
+
+Frustum extractFrustum(const Math::Mat4& view_proj);
+
+// Bir parçanın görünürlük testi için sınırları: uzayda kutu, zamanda [t_min, t_max].
+struct ChunkBounds {
+    Aabb box;
+    float t_min = -std::numeric_limits<float>::max();
+    float t_max = std::numeric_limits<float>::max();
+
+    bool visible(const Frustum& frustum, float t_start, float t_end) const {
+        return t_max >= t_start && t_min <= t_end && frustum.intersects(box);
+    }
+};
+
+// Nokta bulutlarını sabit boyutlu ardışık indeks aralıklarına böler. Aralıklar ardışık olduğu için köşe
+// indeksi nokta indeksi olarak kalır; görünür parçalar glMultiDrawArrays ile tek çağrıda çizilir.
+struct PointChunks {
+    size_t chunk_size = 4096;
+    std::vector<ChunkBounds> bounds;
+    size_t point_count = 0;
+
+    // Büyüyen veri setinde yalnızca son (yarım) parça ve yeni parçalar güncellenir.
+    void append(const std::vector<DataPoint>& points, const std::vector<double>& times);
+
+    // Görünür parçaların aralıklarını (komşular birleştirilerek) ekler; limit'ten sonraki noktalar çizilmez.
+    void select_ranges(const Frustum& frustum, float t_start, float t_end, size_t limit,
+        std::vector<int>& firsts, std::vector<int>& counts) const;
+};
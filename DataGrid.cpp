@@ -0,0 +1,85 @@
+#include "DataGrid.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+    // Sıralama anahtarı: değer ve satır birlikte tutulur, karşılaştırma sütuna dolaylı erişim gerektirmez
+    struct SortKey {
+        double value;
+        uint32_t row;
+    };
+
+    inline bool key_less(const SortKey& a, const SortKey& b) {
+        return a.value < b.value || (a.value == b.value && a.row < b.row);
+    }
+}
+
+void SortedRowOrder::identity(size_t rows, bool descending) {
+    order.resize(rows);
+    std::iota(order.begin(), order.end(), 0u);
+    if (descending) std::reverse(order.begin(), order.end());
+    inverse.clear();
+}
+
+void SortedRowOrder::sort(const std::vector<double>& column, size_t rows, bool descending) {
+    inverse.clear();
+    size_t valued = std::min(column.size(), rows);
+
+    // NaN olmayan değerler anahtar dizisine; azalan sıralama için değerin işareti çevrilir
+    std::vector<SortKey> keys;
+    keys.reserve(valued);
+    std::vector<uint32_t> missing;
+    double sign = descending ? -1.0 : 1.0;
+    for (size_t i = 0; i < valued; ++i) {
+        if (std::isnan(column[i])) missing.push_back((uint32_t)i);
+        else keys.push_back({ column[i] * sign, (uint32_t)i });
+    }
+    for (size_t i = valued; i < rows; ++i) missing.push_back((uint32_t)i);
+
+    // Parçalar ayrı ayrı sıralanır; sınırlar Parallel::for_chunks ile aynı şekilde hesaplanır
+    size_t n = keys.size();
+    size_t chunks = Parallel::chunk_count(n, parallel_min_rows);
+    std::vector<size_t> bounds(chunks + 1);
+    for (size_t c = 0; c <= chunks; ++c) bounds[c] = n * c / std::max<size_t>(chunks, 1);
+    Parallel::for_chunks(n, parallel_min_rows, [&](size_t, size_t begin, size_t end)
+    {
+        std::sort(keys.begin() + begin, keys.begin() + end, key_less);
+    });
+
+    // Komşu parçalar her turda ikişer ikişer birleştirilir, her tur kendi içinde paraleldir
+    std::vector<SortKey> scratch(n);
+    for (size_t width = 1; width < chunks; width *= 2) {
+        size_t pairs = (chunks + 2 * width - 1) / (2 * width);
+        Parallel::for_chunks(pairs, 1, [&](size_t, size_t begin, size_t end)
+        {
+            for (size_t p = begin; p < end; ++p) {
+                size_t lo = bounds[p * 2 * width];
+                size_t mid = bounds[std::min(p * 2 * width + width, chunks)];
+                size_t hi = bounds[std::min(p * 2 * width + 2 * width, chunks)];
+                std::merge(keys.begin() + lo, keys.begin() + mid, keys.begin() + mid, keys.begin() + hi, scratch.begin() + lo, key_less);
+            }
+        });
+        keys.swap(scratch);
+    }
+
+    order.resize(rows);
+    Parallel::for_chunks(n, parallel_min_rows, [&](size_t, size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i) order[i] = keys[i].row;
+    });
+    std::copy(missing.begin(), missing.end(), order.begin() + n);
+}
+
+size_t SortedRowOrder::position_of(size_t row) const {
+    if (row >= order.size()) return order.size();
+    if (inverse.size() != order.size()) {
+        inverse.resize(order.size());
+        Parallel::for_chunks(order.size(), parallel_min_rows, [&](size_t, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i) inverse[order[i]] = (uint32_t)i;
+        });
+    }
+    return inverse[row];
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Tablo görünümünde satırların gösterim sırası: sıralı konumdan veri setindeki satır indeksine bir permütasyon.
+// Sütun verisi kopyalanmaz; tablo yalnızca görünen konumlar için row() ile gerçek satırı bulur ve değeri
+// doğrudan sütundan okur. Sıralama, satır aralıklarının iş parçacıklarında ayrı ayrı sıralanıp ikişer ikişer
+// (yine paralel) birleştirilmesiyle yapılır. Eşit değerler satır indeksine göre sıralanır, NaN'lar her zaman sondadır.
+class SortedRowOrder {
+public:
+    // Veri setindeki sırayla (0, 1, ..., rows-1); descending ise tersten
+    void identity(size_t rows, bool descending = false);
+    // rows satırı column değerlerine göre sıralar; sütunda eksik satırlar NaN sayılır
+    void sort(const std::vector<double>& column, size_t rows, bool descending);
+
+    size_t size() const { return order.size(); }
+    uint32_t row(size_t position) const { return order[position]; }
+    // Satırın sıralı konumu (ters permütasyon ilk çağrıda kurulur); satır yoksa size() döner
+    size_t position_of(size_t row) const;
+
+private:
+    // Bu sayıdan az satır içeren parçalar iş parçacıklarına bölünmez
+    static constexpr size_t parallel_min_rows = 1 << 16;
+
+    std::vector<uint32_t> order;
+    mutable std::vector<uint32_t> inverse;
+};
@@ -0,0 +1,49 @@
+#include "DataStructures.hpp"
+#include "Parallel.hpp"
+
+const std::vector<double>& DerivedColumn::get(const SearchableDataset& ds) const {
+    const size_t rows = ds.time_data.size();
+    if (ready.load(std::memory_order_acquire) && cached_rows.load(std::memory_order_acquire) == rows) return values;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // Çekirdekler satır başına bağımsız olduğundan veri seti büyüdüğünde yalnızca yeni satırlar hesaplanır;
+    // satır sayısı azalmışsa veri yeniden yazılmış demektir, baştan hesaplanır.
+    size_t first = ready.load(std::memory_order_relaxed) ? values.size() : 0;
+    if (first > rows) first = 0;
+    if (first < rows || values.size() != rows) {
+        values.resize(rows);
+        Parallel::for_chunks(rows - first, 1 << 14, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = first + begin; i < first + end; ++i) {
+                values[i] = kernel(ds, i);
+            }
+        });
+    }
+    cached_rows.store(rows, std::memory_order_release);
+    ready.store(true, std::memory_order_release);
+    return values;
+}
+
+void DerivedColumn::invalidate() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    ready.store(false, std::memory_order_release);
+    cached_rows.store(0, std::memory_order_release);
+    values.clear();
+    values.shrink_to_fit();
+}
+
+const std::vector<double>* SearchableDataset::find_column(const std::string& column_name) const {
+    const std::vector<double>* raw = nullptr;
+    if (column_name == "t") raw = &time_data;
+    else if (column_name == "x") raw = &x_data;
+    else if (column_name == "y") raw = &y_data;
+    else if (column_name == "z") raw = &z_data;
+    else if (column_name == "range") raw = &range_data;
+    else if (column_name == "bearing") raw = &bearing_data;
+    else if (column_name == "elevation") raw = &elevation_data;
+    if (raw && !raw->empty()) return raw;
+
+    for (const auto& column : derived_columns) {
+        if (column.name == column_name) return &column.get(*this);
+    }
+    return nullptr;
+}
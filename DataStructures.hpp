@@ -3,6 +3,10 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <limits>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 
 // 3D uzaydaki bir noktayı temsil eder (hem LLA hem ECEF için kullanılabilir).
 struct DataPoint {
@@ -15,9 +19,62 @@ struct DataField {
     std::function<double(size_t)> getter;
 };
 
+// Bir sütunun özet istatistikleri. NaN değerler min/max/ortalama hesabına katılmaz, ayrıca sayılır.
+struct ColumnStats {
+    std::string name;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    double mean = 0.0;
+    double m2 = 0.0; // Ortalamadan sapmaların kareleri toplamı
+    size_t count = 0;
+    size_t nan_count = 0;
+
+    double variance() const { return count > 1 ? m2 / (count - 1) : 0.0; }
+    double max_abs() const { return count > 0 ? std::max(-min, max) : 0.0; }
+};
+
+struct SearchableDataset;
+
+// Satır başına bir çekirdek fonksiyonla tanımlanan türetilmiş sütun. Değerler ilk erişimde paralel
+// hesaplanır ve önbelleğe alınır; kullanılmayan sütunlar için bellek ve hesap maliyeti oluşmaz.
+// Veri setine satır eklendiğinde önbellek yalnızca yeni satırlar için genişletilir.
+struct DerivedColumn {
+    using Kernel = std::function<double(const SearchableDataset&, size_t)>;
+
+    std::string name;
+    Kernel kernel;
+
+    DerivedColumn(std::string name, Kernel kernel) : name(std::move(name)), kernel(std::move(kernel)) {}
+    // Kopyalar önbelleği paylaşmaz, gerekirse kendi verileri üzerinden yeniden hesaplar.
+    DerivedColumn(const DerivedColumn& other) : name(other.name), kernel(other.kernel) {}
+    DerivedColumn& operator=(const DerivedColumn& other) {
+        if (this != &other) {
+            std::lock_guard<std::mutex> lock(mutex);
+            name = other.name;
+            kernel = other.kernel;
+            values.clear();
+            ready.store(false);
+            cached_rows.store(0);
+        }
+        return *this;
+    }
+
+    // Önbellekteki değerleri döndürür, eksik satırları gerekirse hesaplar (iş parçacığı güvenli).
+    const std::vector<double>& get(const SearchableDataset& ds) const;
+    // Önbelleği boşaltır; mevcut satırlar değiştiğinde (örn. koordinat sistemi yeniden hesaplandığında) çağrılmalıdır.
+    void invalidate() const;
+
+private:
+    mutable std::mutex mutex;
+    mutable std::atomic<bool> ready{ false };
+    mutable std::atomic<size_t> cached_rows{ 0 };
+    mutable std::vector<double> values;
+};
+
 // Grafikte çizdirilecek ve içinde arama yapılabilecek bir veri setini temsil eder.
 struct SearchableDataset {
     std::string name;
+    std::string source_path; // Verinin okunduğu kayıt dosyası (varsa), istatistik önbelleği bunun yanına yazılır
 
     // Orijine göreli çizim noktaları (OpenGL koordinat sistemine uygun)
     std::vector<DataPoint> points;
@@ -33,9 +90,30 @@ struct SearchableDataset {
     std::vector<double> y_data;
     std::vector<double> z_data;
 
-    // Menzil, Yanca, Yükseliş verileri (varsa)
+    // Menzil, Yanca, Yükseliş verileri (ölçülmüşse ham veri olarak; aksi halde türetilmiş sütun olabilir)
     std::vector<double> range_data;
     std::vector<double> bearing_data;
     std::vector<double> elevation_data;
+
+    // İlk erişimde hesaplanan sütunlar
+    std::vector<DerivedColumn> derived_columns;
+
+    // Ölçümü yapan sensörün konumu (RBE verisi sensöre göre olan veri setleri için)
+    DataPoint sensor_lla = { 0, 0, 0 };
+    DataPoint sensor_ecef = { 0, 0, 0 };
+
+    // Sütun istatistikleri (bkz. Statistics.hpp)
+    std::vector<ColumnStats> column_stats;
+
+    const ColumnStats* stats(const std::string& column_name) const {
+        for (const auto& s : column_stats) {
+            if (s.name == column_name) return &s;
+        }
+        return nullptr;
+    }
+
+    // Ada göre sütun: t, x, y, z, range, bearing, elevation (ham veri varsa) veya türetilmiş sütunlar.
+    // Türetilmiş sütun ilk çağrıda hesaplanır. Sütun yoksa nullptr döner.
+    const std::vector<double>* find_column(const std::string& column_name) const;
 };
 
@@ -0,0 +1,66 @@
+#include "DatasetGeometry.hpp"
+#include <algorithm>
+
+size_t GeometryUpdate::bytes() const {
+    return chunks.size() * sizeof(QuantChunk)
+        + (base_vertices.size() + coarse_vertices.size()) * sizeof(QuantizedVertex)
+        + (times.size() + coarse_times.size()) * sizeof(float);
+}
+
+void DatasetGeometry::update(const SearchableDataset& dataset, GeometryUpdate& out) {
+    out = {};
+    is_line_series = dataset.is_line_series;
+    size_t point_count = dataset.points.size();
+
+    // Yeni noktalar 0. seviyeye (köşe indeksi = nokta indeksi), değişen kaba köşeler kaba tampona eklenir.
+    // Kaba köşeler yalnızca son (yarım) parça ve yeni parçalar için yeniden üretilir.
+    size_t first_point = points_done;
+    size_t dirty_from = is_line_series ? lod.append(dataset.points, dataset.time_data) : 0;
+    if (!is_line_series) point_chunks.append(dataset.points, dataset.time_data);
+    const auto& coarse = lod.coarse_vertices;
+
+    std::vector<Math::Vec3> positions;
+    for (;;) {
+        positions.resize(point_count - first_point);
+        for (size_t p = first_point; p < point_count; ++p) {
+            const auto& pt = dataset.points[p];
+            positions[p - first_point] = { (float)pt.x, (float)pt.z, (float)-pt.y };
+        }
+        out.base_vertices.clear();
+        out.coarse_vertices.clear();
+        if (quantizer.append(positions.data(), positions.size(), out.base_vertices) &&
+            quantizer.append(coarse.data() + dirty_from, coarse.size() - dirty_from, out.coarse_vertices)) {
+            break;
+        }
+        // Parça tablosu taştı (çok dağınık veri): parçalar büyütülüp tüm veri seti yeniden sıkıştırılır
+        quantizer = VertexQuantizer(quantizer.max_extent() * 2.0f);
+        chunks_done = 0;
+        first_point = 0;
+        dirty_from = 0;
+    }
+    out.first_point = first_point;
+    out.first_coarse = dirty_from;
+    points_done = point_count;
+
+    // Parçalar oluşturulduktan sonra değişmediğinden parça tablosuna da yalnızca yeniler eklenir
+    const auto& chunks = quantizer.chunks();
+    out.first_chunk = chunks_done;
+    out.chunks.assign(chunks.begin() + chunks_done, chunks.end());
+    chunks_done = chunks.size();
+
+    // Zaman penceresi süzgeci için nokta başına zaman akışı (konumlardan bağımsız tamponda)
+    const auto& times = dataset.time_data;
+    size_t time_count = std::min(times.size(), point_count);
+    out.first_time = std::min(times_done, time_count);
+    out.times.assign(times.begin() + out.first_time, times.begin() + time_count);
+    times_done = time_count;
+
+    // Kaba köşelerin zamanları, temsil ettikleri orijinal noktadan alınır
+    if (is_line_series && time_count > 0) {
+        const auto& source = lod.coarse_source_index;
+        out.coarse_times.reserve(source.size() - dirty_from);
+        for (size_t v = dirty_from; v < source.size(); ++v) {
+            out.coarse_times.push_back(source[v] < time_count ? (float)times[source[v]] : 0.0f);
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include "DataStructures.hpp"
+#include "TrajectoryLod.hpp"
+#include "Culling.hpp"
+#include "VertexQuantizer.hpp"
+
+// Bir veri seti güncellemesinde GPU'ya gönderilecek köşe verisi. Her akış kendi tamponunda first_* indeksinden
+// itibaren yazılır (öncesi geçerli kalır, sonrası atılır); ilk yüklemede tüm indeksler 0'dır.
+struct GeometryUpdate {
+    size_t first_chunk = 0;
+    std::vector<QuantChunk> chunks;
+    size_t first_point = 0;
+    std::vector<QuantizedVertex> base_vertices;
+    size_t first_time = 0;
+    std::vector<float> times;
+    size_t first_coarse = 0;
+    std::vector<QuantizedVertex> coarse_vertices;
+    std::vector<float> coarse_times;    // coarse_vertices ile aynı indeksten başlar (zaman yoksa boş)
+
+    size_t bytes() const;
+};
+
+// Bir veri setinin çizim için CPU tarafında tutulan yapıları: detay seviyesi piramidi (çizgi serileri),
+// kırpma parçaları (nokta bulutları) ve köşe sıkıştırıcısı. GL çağrısı yapmadığından arka plan iş
+// parçacığında kurulup sonra Renderer'a taşınabilir.
+class DatasetGeometry {
+public:
+    bool is_line_series = false;
+    TrajectoryLod lod;          // Yalnızca çizgi serileri
+    PointChunks point_chunks;   // Yalnızca nokta bulutları
+    VertexQuantizer quantizer;
+
+    // Son çağrıdan beri eklenen noktaları işler ve yüklenmesi gereken köşeleri out'a yazar.
+    void update(const SearchableDataset& dataset, GeometryUpdate& out);
+
+    size_t point_count() const { return points_done; }
+
+private:
+    size_t points_done = 0, times_done = 0, chunks_done = 0;
+};
@@ -0,0 +1,185 @@
+#include "DrawSubmission.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <numeric>
+#include <cstring>
+
+void ProgramUniforms::resolve(GLuint program_id) {
+    program = program_id;
+    model = glGetUniformLocation(program, "model");
+    object_id = glGetUniformLocation(program, "object_id");
+    object_color = glGetUniformLocation(program, "object_color");
+    pick_index_flag = glGetUniformLocation(program, "pick_index_flag");
+    use_color_attribute = glGetUniformLocation(program, "use_color_attribute");
+    use_size_attribute = glGetUniformLocation(program, "use_size_attribute");
+    use_time_window = glGetUniformLocation(program, "use_time_window");
+    round_points = glGetUniformLocation(program, "round_points");
+    color_range = glGetUniformLocation(program, "color_range");
+    size_range = glGetUniformLocation(program, "size_range");
+    point_size_px = glGetUniformLocation(program, "point_size_px");
+    residual_scale = glGetUniformLocation(program, "residual_scale");
+}
+
+void RenderQueue::register_program(GLuint program) {
+    ProgramUniforms locations;
+    locations.resolve(program);
+    programs.push_back(locations);
+    uniform_cache.push_back({ program, {}, false });
+    GLuint block = glGetUniformBlockIndex(program, "Frame");
+    if (block != GL_INVALID_INDEX) glUniformBlockBinding(program, block, frame_block_binding);
+}
+
+void RenderQueue::clear() {
+    items.clear();
+    uniform_values.clear();
+    firsts.clear();
+    counts.clear();
+    current_group = "Sahne";
+}
+
+void RenderQueue::push(const DrawState& state, const DrawUniforms& uniforms, Kind kind, GLint first, GLsizei count, uint32_t ranges_begin) {
+    // Art arda aynı uniform'larla eklenen öğeler (ör. bir veri setinin tam ve kaba seviyeleri) tek kopya paylaşır
+    if (uniform_values.empty() || memcmp(&uniform_values.back(), &uniforms, sizeof(DrawUniforms)) != 0) {
+        uniform_values.push_back(uniforms);
+    }
+    items.push_back({ state, kind, first, count, ranges_begin, (uint32_t)(uniform_values.size() - 1), current_group });
+}
+
+void RenderQueue::draw_arrays(const DrawState& state, const DrawUniforms& uniforms, GLint first, GLsizei count) {
+    if (count <= 0) return;
+    push(state, uniforms, Kind::Arrays, first, count, 0);
+}
+
+void RenderQueue::multi_draw_arrays(const DrawState& state, const DrawUniforms& uniforms, const std::vector<GLint>& range_firsts, const std::vector<GLsizei>& range_counts) {
+    if (range_firsts.empty()) return;
+    uint32_t begin = (uint32_t)firsts.size();
+    firsts.insert(firsts.end(), range_firsts.begin(), range_firsts.end());
+    counts.insert(counts.end(), range_counts.begin(), range_counts.end());
+    push(state, uniforms, Kind::MultiArrays, 0, (GLsizei)range_firsts.size(), begin);
+}
+
+void RenderQueue::draw_elements(const DrawState& state, const DrawUniforms& uniforms, GLsizei count) {
+    if (count <= 0) return;
+    push(state, uniforms, Kind::Elements, 0, count, 0);
+}
+
+void RenderQueue::draw_arrays_instanced(const DrawState& state, const DrawUniforms& uniforms, GLint first, GLsizei count, GLsizei instance_count) {
+    if (count <= 0 || instance_count <= 0) return;
+    push(state, uniforms, Kind::ArraysInstanced, first, count, (uint32_t)instance_count);
+}
+
+void RenderQueue::draw_elements_instanced(const DrawState& state, const DrawUniforms& uniforms, GLsizei count, GLsizei instance_count) {
+    if (count <= 0 || instance_count <= 0) return;
+    push(state, uniforms, Kind::ElementsInstanced, 0, count, (uint32_t)instance_count);
+}
+
+void RenderQueue::apply_uniforms(const ProgramUniforms& loc, ProgramCache& cache, const DrawUniforms& v) {
+    const DrawUniforms& c = cache.values;
+    const bool all = !cache.valid;
+    if (loc.model >= 0 && (all || memcmp(c.model.m, v.model.m, sizeof(v.model.m)) != 0)) glUniformMatrix4fv(loc.model, 1, GL_FALSE, v.model.m);
+    if (loc.object_id >= 0 && (all || c.object_id != v.object_id)) glUniform1ui(loc.object_id, v.object_id);
+    if (loc.object_color >= 0 && (all || memcmp(c.object_color, v.object_color, sizeof(v.object_color)) != 0)) glUniform3fv(loc.object_color, 1, v.object_color);
+    if (loc.pick_index_flag >= 0 && (all || c.pick_index_flag != v.pick_index_flag)) glUniform1ui(loc.pick_index_flag, v.pick_index_flag);
+    if (loc.use_color_attribute >= 0 && (all || c.use_color_attribute != v.use_color_attribute)) glUniform1i(loc.use_color_attribute, v.use_color_attribute);
+    if (loc.use_size_attribute >= 0 && (all || c.use_size_attribute != v.use_size_attribute)) glUniform1i(loc.use_size_attribute, v.use_size_attribute);
+    if (loc.use_time_window >= 0 && (all || c.use_time_window != v.use_time_window)) glUniform1i(loc.use_time_window, v.use_time_window);
+    if (loc.round_points >= 0 && (all || c.round_points != v.round_points)) glUniform1i(loc.round_points, v.round_points);
+    if (loc.color_range >= 0 && (all || memcmp(c.color_range, v.color_range, sizeof(v.color_range)) != 0)) glUniform2fv(loc.color_range, 1, v.color_range);
+    if (loc.size_range >= 0 && (all || memcmp(c.size_range, v.size_range, sizeof(v.size_range)) != 0)) glUniform2fv(loc.size_range, 1, v.size_range);
+    if (loc.point_size_px >= 0 && (all || memcmp(c.point_size_px, v.point_size_px, sizeof(v.point_size_px)) != 0)) glUniform2fv(loc.point_size_px, 1, v.point_size_px);
+    if (loc.residual_scale >= 0 && (all || c.residual_scale != v.residual_scale)) glUniform1f(loc.residual_scale, v.residual_scale);
+    cache.values = v;
+    cache.valid = true;
+}
+
+void RenderQueue::submit(Profiler* profiler) {
+    order.resize(items.size());
+    std::iota(order.begin(), order.end(), 0u);
+    // Pahalı durum değişiklikleri (program) en dışta, ucuz olanlar (VAO) en içte; eşitlikte ekleme sırası korunur
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        const DrawState& x = items[a].state;
+        const DrawState& y = items[b].state;
+        if (x.program != y.program) return x.program < y.program;
+        if (x.program_point_size != y.program_point_size) return x.program_point_size < y.program_point_size;
+        // GL_LEQUAL öğeleri aynı programın GL_LESS öğelerinden sonra çizilir (üzerlerine binen vurgular)
+        if (x.depth_func != y.depth_func) return x.depth_func < y.depth_func;
+        if (x.line_width != y.line_width) return x.line_width < y.line_width;
+        if (x.buffer_texture != y.buffer_texture) return x.buffer_texture < y.buffer_texture;
+        return x.vao < y.vao;
+    });
+
+    for (auto& cache : uniform_cache) cache.valid = false;
+    DrawState current;
+    bool first_item = true;
+    size_t program_idx = 0;
+    size_t changes = 0;
+    const char* open_group = nullptr;
+    for (uint32_t idx : order) {
+        const Item& item = items[idx];
+        const DrawState& s = item.state;
+        if (profiler && item.group != open_group) {
+            profiler->gpu_begin(item.group);
+            open_group = item.group;
+        }
+        if (first_item || s.program != current.program) {
+            glUseProgram(s.program);
+            program_idx = 0;
+            while (program_idx < programs.size() && programs[program_idx].program != s.program) program_idx++;
+            changes++;
+        }
+        if (first_item || s.program_point_size != current.program_point_size) {
+            if (s.program_point_size) glEnable(GL_PROGRAM_POINT_SIZE);
+            else glDisable(GL_PROGRAM_POINT_SIZE);
+            changes++;
+        }
+        if (first_item || s.depth_func != current.depth_func) {
+            glDepthFunc(s.depth_func);
+            changes++;
+        }
+        if (first_item || s.line_width != current.line_width) {
+            glLineWidth(s.line_width);
+            changes++;
+        }
+        if (first_item || s.buffer_texture != current.buffer_texture) {
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_BUFFER, s.buffer_texture);
+            changes++;
+        }
+        if (first_item || s.vao != current.vao) {
+            glBindVertexArray(s.vao);
+            changes++;
+        }
+        current = s;
+        first_item = false;
+
+        if (program_idx < programs.size()) {
+            apply_uniforms(programs[program_idx], uniform_cache[program_idx], uniform_values[item.uniforms]);
+        }
+
+        switch (item.kind) {
+        case Kind::Arrays:
+            glDrawArrays(s.mode, item.first, item.count);
+            break;
+        case Kind::MultiArrays:
+            glMultiDrawArrays(s.mode, firsts.data() + item.ranges_begin, counts.data() + item.ranges_begin, item.count);
+            break;
+        case Kind::Elements:
+            glDrawElements(s.mode, item.count, GL_UNSIGNED_INT, 0);
+            break;
+        case Kind::ArraysInstanced:
+            glDrawArraysInstanced(s.mode, item.first, item.count, (GLsizei)item.ranges_begin);
+            break;
+        case Kind::ElementsInstanced:
+            glDrawElementsInstanced(s.mode, item.count, GL_UNSIGNED_INT, 0, (GLsizei)item.ranges_begin);
+            break;
+        }
+    }
+    if (open_group) profiler->gpu_end();
+    if (!items.empty()) {
+        glDisable(GL_PROGRAM_POINT_SIZE);
+        glDepthFunc(GL_LESS);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glBindVertexArray(0);
+    }
+    last_state_changes = changes;
+}
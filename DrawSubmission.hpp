@@ -0,0 +1,110 @@
+#pragma once
+
+#define GLFW_INCLUDE_NONE
+#include <glad/glad.h>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Math.hpp"
+
+class Profiler;
+
+// Bir çizim öğesinin uniform değerleri. Hangi alanların kullanıldığı programa bağlıdır;
+// programda bulunmayan uniform'lar atlanır.
+struct DrawUniforms {
+    Math::Mat4 model = Math::identity();
+    GLuint object_id = 0;
+    float object_color[3] = { 1.0f, 1.0f, 1.0f };
+    GLuint pick_index_flag = 0;
+    GLint use_color_attribute = 0;
+    GLint use_size_attribute = 0;
+    GLint use_time_window = 0;
+    GLint round_points = 0;
+    float color_range[2] = { 0.0f, 1.0f };
+    float size_range[2] = { 0.0f, 1.0f };
+    float point_size_px[2] = { 1.0f, 1.0f };
+    float residual_scale = 1.0f;
+};
+
+// Bir programın uniform konumları; program kaydedilirken bir kez çözülür (-1: programda yok).
+struct ProgramUniforms {
+    GLuint program = 0;
+    GLint model = -1, object_id = -1, object_color = -1, pick_index_flag = -1;
+    GLint use_color_attribute = -1, use_size_attribute = -1, use_time_window = -1, round_points = -1;
+    GLint color_range = -1, size_range = -1, point_size_px = -1, residual_scale = -1;
+
+    void resolve(GLuint program_id);
+};
+
+// Çizim öğesinin boru hattı durumu. Öğeler bu alanlara göre sıralanır, böylece aynı durumu paylaşanlar art arda gelir.
+struct DrawState {
+    GLuint program = 0;
+    GLuint vao = 0;
+    GLenum mode = GL_TRIANGLES;
+    float line_width = 1.0f;
+    GLuint buffer_texture = 0;      // 0. birime bağlanan GL_TEXTURE_BUFFER (yoksa 0)
+    bool program_point_size = false;
+    GLenum depth_func = GL_LESS;    // Aynı köşeleri tekrar çizen geçişler (vurgu) için GL_LEQUAL
+};
+
+// Kare boyunca toplanan çizim öğelerini durumlarına göre sıralayıp gönderen katman.
+// Uniform konumları önceden çözülür; program, VAO, çizgi kalınlığı, derinlik testi, doku ve uniform değerleri için
+// son gönderilen değer tutulur ve değişmeyen durum sürücüye tekrar gönderilmez.
+class RenderQueue {
+public:
+    // Kare başına ortak uniform'lar (kamera, zaman penceresi) için std140 blok.
+    // Programlardaki "Frame" bloğu bu bağlama noktasına bağlanır.
+    static constexpr GLuint frame_block_binding = 0;
+
+    // Programı kuyruğa tanıtır: uniform konumlarını çözer ve "Frame" bloğunu bağlama noktasına bağlar.
+    void register_program(GLuint program);
+
+    void clear();
+    // Sonraki öğelerin ait olduğu çizim grubu (profilleyicide ayrı GPU bölümü olarak görünür)
+    void set_group(const char* name) { current_group = name; }
+    void draw_arrays(const DrawState& state, const DrawUniforms& uniforms, GLint first, GLsizei count);
+    void multi_draw_arrays(const DrawState& state, const DrawUniforms& uniforms, const std::vector<GLint>& firsts, const std::vector<GLsizei>& counts);
+    void draw_elements(const DrawState& state, const DrawUniforms& uniforms, GLsizei count);
+    void draw_arrays_instanced(const DrawState& state, const DrawUniforms& uniforms, GLint first, GLsizei count, GLsizei instance_count);
+    void draw_elements_instanced(const DrawState& state, const DrawUniforms& uniforms, GLsizei count, GLsizei instance_count);
+
+    // Öğeleri sıralar ve gönderir. Çağrı öncesindeki GL durumu bilinmediği için önbellek her gönderimde sıfırlanır.
+    // profiler verilirse her grup değişiminde bir GPU aralığı açılır; sıralama grupları böldüyse aynı grubun
+    // aralıkları profilleyicide toplanır.
+    void submit(Profiler* profiler = nullptr);
+
+    size_t item_count() const { return items.size(); }
+    size_t state_changes() const { return last_state_changes; }
+
+private:
+    enum class Kind : uint8_t { Arrays, MultiArrays, Elements, ArraysInstanced, ElementsInstanced };
+    struct Item {
+        DrawState state;
+        Kind kind;
+        GLint first;
+        GLsizei count;
+        uint32_t ranges_begin;  // MultiArrays: firsts/counts içindeki ilk aralık, *Instanced: örnek sayısı
+        uint32_t uniforms;      // uniform_values içindeki indeks
+        const char* group;
+    };
+
+    std::vector<ProgramUniforms> programs;
+    std::vector<Item> items;
+    std::vector<uint32_t> order;
+    std::vector<DrawUniforms> uniform_values;
+    std::vector<GLint> firsts;
+    std::vector<GLsizei> counts;
+
+    // Durum önbelleği
+    struct ProgramCache {
+        GLuint program = 0;
+        DrawUniforms values;
+        bool valid = false;
+    };
+    std::vector<ProgramCache> uniform_cache;
+    size_t last_state_changes = 0;
+    const char* current_group = "Sahne";
+
+    void push(const DrawState& state, const DrawUniforms& uniforms, Kind kind, GLint first, GLsizei count, uint32_t ranges_begin);
+    void apply_uniforms(const ProgramUniforms& locations, ProgramCache& cache, const DrawUniforms& values);
+};
@@ -1,12 +1,28 @@
 #include "InteractivePlotter.hpp"
 #include "Renderer.hpp"
+#include "SpatialIndex.hpp"
+#include "Association.hpp"
+#include "Statistics.hpp"
 #include "Math.hpp"
+#include "DatasetGeometry.hpp"
+#include "Parallel.hpp"
+#include "Profiler.hpp"
+#include "SceneWorker.hpp"
+#include "TimeSeries.hpp"
+#include "DataGrid.hpp"
 #include <iostream>
 #include <numbers>
 #include <limits>
 #include <string>
 #include <algorithm>
 #include <cmath>
+#include <cfloat>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
 
 #define GLFW_INCLUDE_NONE
 #include <glad/glad.h>
@@ -20,19 +36,25 @@ static void glfw_error_callback(int error, const char* description) {
     fprintf(stderr, "Glfw Error %d: %s\n", error, description);
 }
 
-// Veri setlerine göre grid boyutunu hesaplayan yardımcı fonksiyon
+// Veri setlerine göre grid boyutunu hesaplayan yardımcı fonksiyon (yüklemede hesaplanan sütun istatistiklerini kullanır)
 std::pair<float, int> calculate_grid_properties(const std::vector<SearchableDataset>& datasets) {
     float max_abs_coord = 1000.0f;
     bool data_found = false;
     for (const auto& ds : datasets) {
         if (!ds.points.empty()) {
             data_found = true;
-            double current_max = 0.0;
-            for (const auto& p : ds.points) {
-                if (std::abs(p.x) > current_max) current_max = std::abs(p.x);
-                if (std::abs(p.y) > current_max) current_max = std::abs(p.y);
-                if (std::abs(p.z) > current_max) current_max = std::abs(p.z);
+            std::vector<ColumnStats> computed;
+            const ColumnStats* px = ds.stats("px");
+            const ColumnStats* py = ds.stats("py");
+            const ColumnStats* pz = ds.stats("pz");
+            if (!px || !py || !pz) {
+                // İstatistiği olmadan gelen veri setleri için yalnızca çizim sütunları hesaplanır
+                std::vector<ColumnView> columns = datasetColumns(ds);
+                std::erase_if(columns, [](const ColumnView& c) { return c.name != "px" && c.name != "py" && c.name != "pz"; });
+                computed = computeColumnStatistics(columns);
+                px = &computed[0]; py = &computed[1]; pz = &computed[2];
             }
+            double current_max = std::max({ px->max_abs(), py->max_abs(), pz->max_abs() });
             if (current_max > max_abs_coord) {
                 max_abs_coord = static_cast<float>(current_max);
             }
@@ -45,18 +67,82 @@ std::pair<float, int> calculate_grid_properties(const std::vector<SearchableData
 }
 
 
+// Nokta bulutlarının renk/boyut özniteliği olarak seçilebilen sütunlar (anahtar boşsa sabit görünüm)
+struct PointAttributeOption {
+    const char* key;
+    const char* label;
+};
+static const PointAttributeOption point_attribute_options[] = {
+    { "", "Sabit" },
+    { "t", "Zaman" },
+    { "range", "Menzil" },
+    { "bearing", "Yanca" },
+    { "elevation", "Yukselis" },
+    { "err_mag", "Hata Buyuklugu" },
+};
+
+// Veri tablosunun sütunları; "#" satır indeksi, "err_mag" eşleşme tablosundaki artık büyüklüğüdür
+static const PointAttributeOption grid_columns[] = {
+    { "#", "#" },
+    { "t", "Zaman (s)" },
+    { "x", "X (m)" },
+    { "y", "Y (m)" },
+    { "z", "Z (m)" },
+    { "range", "Menzil (m)" },
+    { "bearing", "Yanca (deg)" },
+    { "elevation", "Yukselis (deg)" },
+    { "err_mag", "Hata (m)" },
+};
+
+// Zaman serisi panellerinde zamana karşı çizilebilen sütunlar
+static const PointAttributeOption plot_column_options[] = {
+    { "range", "Menzil" },
+    { "bearing", "Yanca" },
+    { "elevation", "Yukselis" },
+    { "err_mag", "Hata Buyuklugu" },
+    { "x", "ECEF X" },
+    { "y", "ECEF Y" },
+    { "z", "ECEF Z" },
+};
+
+
 // Ana uygulama sınıfı
 class PlotterApp {
 public:
-    PlotterApp(const std::vector<SearchableDataset>& datasets, const DataPoint& radar_pos_relative);
+    PlotterApp(std::vector<SearchableDataset> initial_datasets, const DataPoint& radar_pos_relative, const LiveConfig& live);
     ~PlotterApp();
     void run();
 
 private:
     // Pencere ve Durum
     GLFWwindow* window = nullptr;
-    const std::vector<SearchableDataset>& datasets;
+    std::vector<SearchableDataset> datasets;
     Renderer renderer;
+    Profiler profiler;
+    bool show_profiler = false;
+    int profiler_section = 0;     // Profil penceresinde grafiği çizilen bölüm
+
+    // Zaman serisi grafikleri: her panel bir sütunu görünür veri setleri için zamana karşı çizer. Paneller aynı
+    // zaman eksenini paylaşır; zaman imleci current_time'dır. Piramitler ilk çizimde kurulur, veri büyüdükçe güncellenir.
+    struct PlotPanel {
+        int column_option = 0;              // plot_column_options indeksi
+        std::vector<MinMaxPyramid> pyramids; // Veri seti başına
+    };
+    bool show_time_series = false;
+    bool plot_follow_time = false;
+    double plot_t0 = 0.0, plot_t1 = 0.0;
+    std::vector<PlotPanel> plot_panels;
+
+    // Veri tablosu: bir veri setinin tüm satırları sanallaştırılmış tabloda, yalnızca görünen satırlar biçimlendirilir.
+    // Sıralama veriyi değil grid_order permütasyonunu değiştirir; seçim 3B görünümle iki yönlü eşlenir.
+    bool show_data_grid = false;
+    int grid_dataset_idx = 0;
+    int grid_sort_column = 0;
+    bool grid_sort_descending = false;
+    SortedRowOrder grid_order;
+    size_t grid_order_dataset = std::numeric_limits<size_t>::max();   // grid_order'ın kurulduğu veri seti
+    size_t grid_synced_point = std::numeric_limits<size_t>::max();    // Tablonun en son kaydırıldığı seçili satır
+    double grid_sorted_at = 0.0;
     Math::Mat4 projection_matrix;
     Math::Mat4 view_matrix;
 
@@ -67,7 +153,19 @@ private:
 
     // Sahne Nesneleri
     Math::Mat4 radar_model_matrix;
-    Math::Mat4 target_model_matrix;
+    // Kare başı veri işleri (hedef enterpolasyonu) ve ağır analizler (eşleşme, istatistik, sorgu) çalışma iş
+    // parçacıklarında yapılır; sonuçlar üçlü tamponlu anlık görüntülerle kilitsiz alınır. Veri setlerini yalnızca ana
+    // iş parçacığı değiştirir ve bunu datasets_mutex'in özel kilidini alabildiği karelerde yapar.
+    std::shared_mutex datasets_mutex;
+    SceneWorker scene_worker{ datasets, datasets_mutex };
+    double requested_frame_time = -1.0;             // En son istenen karenin girdileri
+    std::vector<bool> requested_visibility;
+    bool frame_inputs_changed = true;               // Veri setleri büyüdü
+    uint64_t applied_refresh_generation = 0;
+    uint64_t applied_query_generation = 0;
+    std::shared_ptr<const std::vector<std::vector<uint32_t>>> applied_query_matches;
+    // Veri setlerine yazılamadığı (kilit alınamadığı) için bekleyen istatistikler
+    std::shared_ptr<const std::vector<std::pair<size_t, std::vector<ColumnStats>>>> pending_column_stats;
     DataPoint radar_pos_relative;
 
     // Animasyon
@@ -76,6 +174,11 @@ private:
     bool is_playing = false;
     float playback_speed = 1.0f;
 
+    // Zaman penceresi: yalnızca [t_start, t_end] aralığındaki örnekler çizilir ve seçilebilir
+    enum TimeWindowMode { TIME_WINDOW_ALL = 0, TIME_WINDOW_UNTIL_NOW, TIME_WINDOW_TRAIL };
+    int time_window_mode = TIME_WINDOW_ALL;
+    float trail_seconds = 60.0f;
+
     // UI Durumu
     std::vector<bool> visibility;
     size_t selected_dataset_idx = std::numeric_limits<size_t>::max();
@@ -90,11 +193,110 @@ private:
     std::vector<PinnedPoint> pinned_points;
     size_t next_pin_uid = 0;
 
+    // Ölçüm-gerçek eşleşme tabloları (yüklemede kurulur, canlı modda analiz iş parçacığında yenilenir)
+    std::shared_ptr<const std::vector<AssociationTable>> association_tables;
+    const AssociationTable& association(size_t dataset_idx) const {
+        static const AssociationTable empty_table;
+        return association_tables && dataset_idx < association_tables->size() ? (*association_tables)[dataset_idx] : empty_table;
+    }
+
+    // Seçim için her veri setinin noktaları üzerine kurulan BVH'ler (hazır olmayanlar boş)
+    std::vector<std::shared_ptr<const PointBVH>> pick_indices;
+
+    // Arka planda yükleme: köşe üretimi, BVH ve eşleşme tabloları iş parçacıklarında hazırlanır, pencere
+    // hemen açılır. Hazır olan veri setleri ana iş parçacığında kare başına upload_budget_bytes kadar yüklenir.
+    struct LoadedDataset {
+        size_t dataset_idx;
+        DatasetGeometry geometry;
+        GeometryUpdate update;
+        PointBVH pick_index;
+    };
+    static constexpr size_t upload_budget_bytes = 4 * 1024 * 1024;
+    std::thread loader_thread;
+    std::mutex loader_mutex;
+    std::vector<LoadedDataset> loaded_datasets;         // loader_mutex ile korunur
+    std::vector<AssociationTable> loaded_associations;  // loader_mutex ile korunur
+    bool associations_loaded = false;                   // loader_mutex ile korunur
+    std::atomic<bool> loading_finished = false;
+    std::atomic<bool> cancel_loading = false;
+    size_t datasets_prepared = 0;
+
+    // Canlı mod: alıcı iş parçacığının yığınları ilk yükleme bittikten sonra veri setlerine eklenir ve GPU'ya
+    // sync_dataset ile yalnızca yeni noktalar gönderilir. Seçim indeksleri, istatistikler ve eşleşme tabloları
+    // tüm veri üzerinden kurulduğundan en fazla live_refresh_interval saniyede bir yenilenir.
+    static constexpr size_t live_samples_per_frame = 1 << 18;
+    static constexpr double live_refresh_interval = 1.0;
+    LiveConfig live_config;
+    LiveReceiver live_receiver;
+    RecordingFollower live_follower;
+    std::string live_error;
+    bool live_follow = true;            // Zaman imleci en son örneği izler
+    std::vector<bool> live_touched;     // Son yenilemeden beri büyüyen veri setleri
+    double live_refreshed_at = 0.0;
+    uint64_t live_rejected = 0;
+
+    // GPU ID tamponu ile seçim ve fareyle üzerine gelme (hover) sorguları
+    enum PickTag : uint32_t { PICK_TAG_CLICK = 1, PICK_TAG_HOVER = 2 };
+    bool use_gpu_picking = false;
+    bool hover_pick_in_flight = false;
+    size_t hover_dataset_idx = std::numeric_limits<size_t>::max();
+    size_t hover_point_idx = std::numeric_limits<size_t>::max();
+
+    // Toplu artık alanı (tüm ölçümlerin hata vektörleri); geometri ilk açılışta bir kez üretilir
+    bool show_residual_field = false;
+    float residual_scale = 1.0f;
+    std::vector<size_t> residual_changed_from; // Veri seti başına, alan kapalıyken değişen ilk eşleşme satırı
+
+    // Yoğunluk haritası (nokta bulutları) ve yukarıdan ortografik görünüm
+    bool show_density = false;
+    float density_gain = 32.0f;
+    bool top_down_view = false;
+
+    // Nokta bulutu görünümü (point_attribute_options indeksleri)
+    int point_color_option = 0;
+    int point_size_option = 0;
+
+    // İsteğe bağlı çizim: sahne FBO'su yalnızca aşağıdaki durum değiştiğinde yeniden çizilir, arayüz her kare çizilir
+    struct SceneState {
+        float cam_yaw, cam_pitch, cam_distance;
+        float cam_center_x, cam_center_y, cam_center_z;
+        float current_time;
+        int time_window_mode;
+        float trail_seconds;
+        size_t selected_dataset_idx, selected_point_idx;
+        bool show_residual_field;
+        float residual_scale;
+        bool show_density;
+        float density_gain;
+        bool top_down_view;
+
+        bool operator==(const SceneState&) const = default;
+    };
+    SceneState last_scene_state = {};
+    std::vector<bool> last_visibility;
+    bool scene_dirty = true;   // Durumdan çıkarılamayan değişiklikler (veri, görünüm ayarları, hata vektörleri)
+    int idle_frames = 0;       // Sahnenin değişmediği ardışık kare sayısı
+
+    // Sahne FBO'su görüntü alanı boyutunu izler. Dinamik çözünürlükte, art arda yeniden çizilen karelerin
+    // süresi bütçeyi aşarsa FBO ölçeği düşürülür, bütçenin epey altında kalırsa tekrar yükseltilir.
+    bool dynamic_resolution = false;
+    float resolution_scale = 1.0f;
+    int msaa_option = 0;             // 0: kapalı, 1: 2x, 2: 4x, 3: 8x
+    float frame_dt = 0.0f;
+    bool redrew_last_frame = false;
+    int slow_frames = 0, fast_frames = 0;
+
     // Arama
     int search_dataset_idx_int = 0;
     char searchQuery[128] = "";
     bool show_search_warning = false;
 
+    // Sütun sorgusu: eşleşen satırlar veri seti başına artan indeks listesi olarak tutulur ve 3B görünümde vurgulanır
+    char query_text[256] = "";
+    std::vector<std::vector<uint32_t>> query_matches;
+    std::vector<std::string> query_columns;
+    std::string query_message;
+
 
     // Ana Fonksiyonlar
     void init_window();
@@ -104,22 +306,51 @@ private:
 
     // Yardımcı Fonksiyonlar
     void update(float dt);
-    size_t find_truth_dataset_idx();
+    void start_loading();
+    void stop_loading();
+    void poll_loading();
+    bool live_active() const { return live_receiver.running() || live_follower.running(); }
+    void poll_live();
+    void apply_analysis();
+    void apply_column_stats();
+    bool is_loading() const { return !loading_finished || renderer.has_pending_uploads(); }
+    void render_loading_indicator(const ImVec2& viewport_pos, const ImVec2& viewport_size);
+    void render_profiler_window();
+    void render_time_series_window();
+    void render_data_grid_window();
+    void sort_data_grid();
+    void render_plot_panel(PlotPanel& panel, int panel_idx, float height);
+    bool update_plot_series(MinMaxPyramid& pyramid, size_t dataset_idx, const std::string& key);
     size_t find_closest_time_index(const SearchableDataset& ds, double time);
     void handle_input(const ImVec2& viewport_pos, const ImVec2& viewport_size);
+    void pick_point_cpu(const ImVec2& viewport_pos, const ImVec2& viewport_size);
+    void process_gpu_picks();
+    void select_and_pin(size_t dataset_idx, size_t point_idx);
+    bool point_attribute_values(size_t dataset_idx, const std::string& key, std::vector<float>& values, float& vmin, float& vmax);
+    void apply_point_style();
+    void upload_residual_field();
+    void run_query();
+    void clear_query();
+    void export_query_results(const std::string& path);
+    bool time_window(float& t_start, float& t_end) const;
+    bool scene_needs_redraw();
     void render_ui();
-    void render_scene();
+    void render_scene(const ImVec2& viewport_size);
+    void update_resolution_scale();
     void render_pinned_point_windows(const ImVec2& viewport_pos, const ImVec2& viewport_size);
 };
 
-PlotterApp::PlotterApp(const std::vector<SearchableDataset>& datasets, const DataPoint& radar_pos_relative)
-    : datasets(datasets), radar_pos_relative(radar_pos_relative)
+PlotterApp::PlotterApp(std::vector<SearchableDataset> initial_datasets, const DataPoint& radar_pos_relative, const LiveConfig& live)
+    : datasets(std::move(initial_datasets)), radar_pos_relative(radar_pos_relative), live_config(live)
 {
     auto [size, lines] = calculate_grid_properties(datasets);
     grid_size = size;
     cam_distance = grid_size * 0.5f;
     visibility.resize(datasets.size(), true);
 
+    // Eşleşme tabloları ve seçim indeksleri arka planda kurulana kadar boş kalır
+    pick_indices.resize(datasets.size());
+
     // Max animasyon zamanını bul
     for (const auto& ds : datasets) {
         if (!ds.time_data.empty() && ds.time_data.back() > max_time) {
@@ -129,7 +360,17 @@ PlotterApp::PlotterApp(const std::vector<SearchableDataset>& datasets, const Dat
 
     init_window();
     init_imgui();
-    renderer.initialize(datasets, grid_size);
+    renderer.initialize(datasets.size(), grid_size);
+    renderer.set_profiler(&profiler);
+    start_loading();
+    // Çalışma iş parçacıklarının sonuçları boşta bekleyen olay döngüsünü uyandırır
+    scene_worker.start([]() { glfwPostEmptyEvent(); });
+    if (live_config.udp_port != 0 && !live_receiver.start(live_config.udp_port, live_error)) {
+        std::cerr << "Canli mod baslatilamadi: " << live_error << std::endl;
+    }
+    if (!live_config.follow_path.empty() && !live_follower.start(live_config.follow_path, live_config.follow_stream, live_config.origin_lla, live_error)) {
+        std::cerr << "Kayit izlenemiyor: " << live_error << std::endl;
+    }
 
     // Radar model matrisini ayarla
     Math::Vec3 radar_gl_pos = { (float)radar_pos_relative.x, (float)radar_pos_relative.z, (float)-radar_pos_relative.y };
@@ -137,9 +378,612 @@ PlotterApp::PlotterApp(const std::vector<SearchableDataset>& datasets, const Dat
 }
 
 PlotterApp::~PlotterApp() {
+    live_receiver.stop();
+    live_follower.stop();
+    scene_worker.stop();
+    stop_loading();
     shutdown();
 }
 
+void PlotterApp::start_loading() {
+    loader_thread = std::thread([this]() {
+        // Veri setleri iş parçacıklarına paylaştırılır; her biri hazır olur olmaz ana iş parçacığına verilir
+        Parallel::for_chunks(datasets.size(), 1, [&](size_t, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end && !cancel_loading; ++i)
+            {
+                LoadedDataset loaded;
+                loaded.dataset_idx = i;
+                loaded.geometry.update(datasets[i], loaded.update);
+                loaded.pick_index.build(datasets[i].points);
+                std::lock_guard<std::mutex> lock(loader_mutex);
+                loaded_datasets.push_back(std::move(loaded));
+            }
+        });
+        if (!cancel_loading) {
+            std::vector<AssociationTable> tables = buildAssociationTables(datasets);
+            std::lock_guard<std::mutex> lock(loader_mutex);
+            loaded_associations = std::move(tables);
+            associations_loaded = true;
+        }
+        loading_finished = true;
+    });
+}
+
+void PlotterApp::stop_loading() {
+    cancel_loading = true;
+    if (loader_thread.joinable()) loader_thread.join();
+}
+
+void PlotterApp::poll_loading() {
+    std::vector<LoadedDataset> ready;
+    bool associations_ready = false;
+    {
+        std::lock_guard<std::mutex> lock(loader_mutex);
+        ready.swap(loaded_datasets);
+        if (associations_loaded) {
+            association_tables = std::make_shared<const std::vector<AssociationTable>>(std::move(loaded_associations));
+            associations_loaded = false;
+            associations_ready = true;
+        }
+    }
+    for (auto& loaded : ready) {
+        renderer.queue_dataset(loaded.dataset_idx, datasets[loaded.dataset_idx], std::move(loaded.geometry), std::move(loaded.update));
+        pick_indices[loaded.dataset_idx] = std::make_shared<const PointBVH>(std::move(loaded.pick_index));
+        // Yükleme bitmeden çalıştırılan sorgunun vurgusu veri seti GPU'ya gelince uygulanır
+        if (loaded.dataset_idx < query_matches.size()) renderer.set_highlight(loaded.dataset_idx, query_matches[loaded.dataset_idx]);
+        datasets_prepared++;
+    }
+    // Artık büyüklüğü gibi eşleşmeye bağlı öznitelikler tablolar gelince yüklenir
+    if (associations_ready) {
+        apply_point_style();
+        if (show_residual_field) upload_residual_field();
+    }
+    if (renderer.upload_pending(upload_budget_bytes)) scene_dirty = true;
+}
+
+void PlotterApp::poll_live() {
+    // Kare başına işlenen örnek sayısı sınırlıdır; kalan yığınlar kuyrukta sonraki kareleri bekler
+    std::vector<LiveSample> batch;
+    std::vector<bool> touched(datasets.size(), false);
+    size_t appended = 0;
+    {
+        // Çalışma iş parçacıkları veri setlerini okurken eklenemez; kilit alınamazsa yığınlar kuyrukta bekler
+        std::unique_lock<std::shared_mutex> lock(datasets_mutex, std::try_to_lock);
+        while (lock.owns_lock() && appended < live_samples_per_frame && (live_receiver.pop(batch) || live_follower.pop(batch))) {
+            live_rejected += appendLiveSamples(datasets, live_config, batch, touched);
+            appended += batch.size();
+        }
+    }
+    if (appended > 0) {
+        live_touched.resize(datasets.size(), false);
+        for (size_t i = 0; i < datasets.size(); ++i) {
+            if (!touched[i]) continue;
+            live_touched[i] = true;
+            renderer.sync_dataset(i, datasets[i]);
+            if (!datasets[i].time_data.empty()) max_time = std::max(max_time, (float)datasets[i].time_data.back());
+        }
+        if (live_follow) current_time = max_time;
+        frame_inputs_changed = true;
+        scene_dirty = true;
+    }
+
+    // Seçim indeksleri, istatistikler ve eşleşme tabloları analiz iş parçacığında yenilenir (bkz. apply_analysis)
+    double now = glfwGetTime();
+    if (now - live_refreshed_at >= live_refresh_interval && std::find(live_touched.begin(), live_touched.end(), true) != live_touched.end()) {
+        scene_worker.request_refresh(live_touched);
+        std::fill(live_touched.begin(), live_touched.end(), false);
+        live_refreshed_at = now;
+    }
+}
+
+// İki eşleşme tablosunun ortak kısmında eşleşmesi veya artığı değişen ilk satır; değişiklik yoksa SIZE_MAX.
+// Canlı modda gerçek yörünge geç geldiğinde daha önce eşleşmesiz kalan ölçümler sonradan eşleşir.
+static size_t first_changed_residual(const AssociationTable& before, const AssociationTable& after) {
+    size_t n = std::min(before.residual_ecef.size(), after.residual_ecef.size());
+    for (size_t i = 0; i < n; ++i) {
+        if (before.is_valid(i) != after.is_valid(i)) return i;
+        if (!after.is_valid(i)) continue;
+        const DataPoint& a = before.residual_ecef[i];
+        const DataPoint& b = after.residual_ecef[i];
+        if (a.x != b.x || a.y != b.y || a.z != b.z) return i;
+    }
+    return SIZE_MAX;
+}
+
+void PlotterApp::apply_analysis() {
+    const AnalysisSnapshot& snapshot = scene_worker.analysis();
+    if (snapshot.refresh_generation != applied_refresh_generation) {
+        applied_refresh_generation = snapshot.refresh_generation;
+        std::vector<size_t> first_changed(datasets.size(), SIZE_MAX);
+        if (snapshot.associations) {
+            for (size_t i = 0; i < datasets.size() && i < snapshot.associations->size(); ++i) {
+                first_changed[i] = first_changed_residual(association(i), (*snapshot.associations)[i]);
+            }
+        }
+        association_tables = snapshot.associations;
+        pending_column_stats = snapshot.column_stats;
+
+        // Seçili öznitelik akışlarına yeni değerler eklenir (yüklenmiş kısım tekrar gönderilmez), aralıklar güncellenir.
+        // Artıkları değişen veri setlerinde err_mag akışı değişen ilk satırdan itibaren yeniden yüklenir.
+        std::vector<bool> refreshed(datasets.size(), false);
+        for (const auto& [i, bvh] : *snapshot.pick_indices) {
+            pick_indices[i] = bvh;
+            refreshed[i] = true;
+        }
+        std::vector<float> values;
+        for (size_t i = 0; i < datasets.size(); ++i) {
+            if (datasets[i].is_line_series || (!refreshed[i] && first_changed[i] == SIZE_MAX)) continue;
+            for (int option : { point_color_option, point_size_option }) {
+                const std::string key = point_attribute_options[option].key;
+                float vmin = 0.0f, vmax = 1.0f;
+                if (key.empty() || !point_attribute_values(i, key, values, vmin, vmax)) continue;
+                renderer.upload_point_attribute(i, key, values, vmin, vmax, key == "err_mag" ? first_changed[i] : SIZE_MAX);
+            }
+        }
+        // err_mag piramitleri yalnızca büyüyerek güncellendiğinden değişen veri setleri için baştan kurulur
+        for (auto& panel : plot_panels) {
+            if (std::string(plot_column_options[panel.column_option].key) != "err_mag") continue;
+            for (size_t i = 0; i < panel.pyramids.size() && i < first_changed.size(); ++i) {
+                if (first_changed[i] != SIZE_MAX) panel.pyramids[i].clear();
+            }
+        }
+        residual_changed_from.resize(datasets.size(), SIZE_MAX);
+        for (size_t i = 0; i < datasets.size(); ++i) residual_changed_from[i] = std::min(residual_changed_from[i], first_changed[i]);
+        apply_point_style();
+        if (show_residual_field) upload_residual_field();
+    }
+
+    if (snapshot.query_generation != applied_query_generation) {
+        applied_query_generation = snapshot.query_generation;
+        query_message = snapshot.query_message;
+        // Hatalı sorgu önceki sonuçları değiştirmez; temizlenmiş sonuçlar yeniden uygulanmaz
+        if (snapshot.query_matches && snapshot.query_matches != applied_query_matches) {
+            applied_query_matches = snapshot.query_matches;
+            query_matches = *snapshot.query_matches;
+            query_columns = snapshot.query_columns;
+            for (size_t i = 0; i < query_matches.size(); ++i) renderer.set_highlight(i, query_matches[i]);
+        }
+        scene_dirty = true;
+    }
+}
+
+void PlotterApp::apply_column_stats() {
+    std::unique_lock<std::shared_mutex> lock(datasets_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) return;
+    for (const auto& [i, stats] : *pending_column_stats) datasets[i].column_stats = stats;
+    pending_column_stats.reset();
+}
+
+void PlotterApp::render_profiler_window() {
+    if (!show_profiler) return;
+    ImGui::SetNextWindowSize(ImVec2(560, 440), ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Profil", &show_profiler)) {
+        const auto& sections = profiler.sections();
+        if (profiler_section >= (int)sections.size()) profiler_section = 0;
+        ImGui::Text("Cizim ogesi: %d, durum degisikligi: %d", (int)renderer.draw_item_count(), (int)renderer.draw_state_changes());
+        ImGui::Text("Sahne FBO: %dx%d", renderer.get_fbo_width(), renderer.get_fbo_height());
+
+        // Seçili bölümün son Profiler::history_size örneği
+        if (!sections.empty()) {
+            const auto& selected = sections[profiler_section];
+            std::vector<float> samples;
+            selected.ordered(samples);
+            char overlay[96];
+            snprintf(overlay, sizeof(overlay), "%s%s: %.2f ms", selected.gpu ? "GPU " : "", selected.name.c_str(), selected.last());
+            ImGui::PlotLines("##profil", samples.data(), (int)samples.size(), 0, overlay, 0.0f, FLT_MAX, ImVec2(-1, 90));
+        }
+
+        ImGui::Columns(7, "profil_tablosu");
+        for (const char* header : { "Bolum", "Son", "Ort", "p50", "p95", "p99", "Maks" }) {
+            ImGui::Text("%s", header);
+            ImGui::NextColumn();
+        }
+        ImGui::Separator();
+        for (int i = 0; i < (int)sections.size(); ++i) {
+            const auto& section = sections[i];
+            float avg, p50, p95, p99, max;
+            section.statistics(avg, p50, p95, p99, max);
+            std::string label = (section.gpu ? "GPU " : "") + section.name;
+            if (ImGui::Selectable(label.c_str(), profiler_section == i, ImGuiSelectableFlags_SpanAllColumns)) {
+                profiler_section = i;
+            }
+            ImGui::NextColumn();
+            for (float value : { section.last(), avg, p50, p95, p99, max }) {
+                ImGui::Text("%.2f", value);
+                ImGui::NextColumn();
+            }
+        }
+        ImGui::Columns(1);
+
+        ImGui::Separator();
+        if (profiler.capturing()) {
+            ImGui::Text("Iz kaydediliyor...");
+        }
+        else {
+            if (ImGui::Button("Iz Kaydet (300 kare)")) {
+                profiler.start_capture("adab_profil.json", 300);
+            }
+            if (!profiler.last_capture_path().empty()) {
+                ImGui::SameLine();
+                ImGui::Text("Son kayit: %s (chrome://tracing)", profiler.last_capture_path().c_str());
+            }
+        }
+    }
+    ImGui::End();
+}
+
+bool PlotterApp::update_plot_series(MinMaxPyramid& pyramid, size_t dataset_idx, const std::string& key) {
+    const auto& ds = datasets[dataset_idx];
+    if (key == "err_mag") {
+        // Artık büyüklükleri eşleşme tablosundan; yalnızca tablo büyüdüğünde yeniden hesaplanır
+        const auto& table = association(dataset_idx);
+        size_t n = std::min(table.residual_ecef.size(), ds.time_data.size());
+        if (n == 0) return false;
+        if (n != pyramid.source_size()) {
+            std::vector<double> magnitudes(n);
+            for (size_t i = 0; i < n; ++i) {
+                const auto& r = table.residual_ecef[i];
+                magnitudes[i] = table.is_valid(i) ? std::sqrt(r.x * r.x + r.y * r.y + r.z * r.z) : std::numeric_limits<double>::quiet_NaN();
+            }
+            pyramid.update(ds.time_data, magnitudes);
+        }
+        return !pyramid.empty();
+    }
+    const std::vector<double>* column = ds.find_column(key);
+    if (!column) return false;
+    pyramid.update(ds.time_data, *column);
+    return !pyramid.empty();
+}
+
+void PlotterApp::render_plot_panel(PlotPanel& panel, int panel_idx, float height) {
+    static const ImU32 palette[] = {
+        IM_COL32(230, 80, 70, 255), IM_COL32(80, 160, 240, 255), IM_COL32(240, 180, 60, 255), IM_COL32(190, 110, 230, 255),
+        IM_COL32(80, 210, 210, 255), IM_COL32(240, 120, 180, 255),
+    };
+    const ImU32 truth_color = IM_COL32(60, 220, 90, 255);
+
+    ImGui::PushID(panel_idx);
+    ImGui::SetNextItemWidth(160);
+    if (ImGui::BeginCombo("##sutun", plot_column_options[panel.column_option].label)) {
+        for (int n = 0; n < IM_ARRAYSIZE(plot_column_options); n++) {
+            if (ImGui::Selectable(plot_column_options[n].label, panel.column_option == n)) {
+                if (panel.column_option != n) panel.pyramids.clear();
+                panel.column_option = n;
+            }
+        }
+        ImGui::EndCombo();
+    }
+    const std::string key = plot_column_options[panel.column_option].key;
+    panel.pyramids.resize(datasets.size());
+
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImVec2 size(std::max(ImGui::GetContentRegionAvail().x, 50.0f), height);
+    ImVec2 corner(origin.x + size.x, origin.y + size.y);
+    ImGui::InvisibleButton("grafik", size, ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonRight);
+    bool hovered = ImGui::IsItemHovered();
+    bool active = ImGui::IsItemActive();
+
+    // Etkileşim: sol tuş zaman imlecini taşır, sağ sürükleme kaydırır, tekerlek fare çevresinde yakınlaştırır
+    ImGuiIO& io = ImGui::GetIO();
+    double span = plot_t1 - plot_t0;
+    double mouse_t = plot_t0 + (io.MousePos.x - origin.x) / size.x * span;
+    if (hovered && io.MouseWheel != 0.0f) {
+        double new_span = std::clamp(span * std::pow(0.85, (double)io.MouseWheel), 1e-3, std::max((double)max_time, 1.0) * 4.0);
+        double anchor = plot_follow_time ? (double)current_time : mouse_t;
+        plot_t0 = anchor - (anchor - plot_t0) * new_span / span;
+        plot_t1 = plot_t0 + new_span;
+    }
+    if (active && ImGui::IsMouseDragging(1)) {
+        double shift = -io.MouseDelta.x / size.x * span;
+        plot_t0 += shift;
+        plot_t1 += shift;
+        plot_follow_time = false;
+    }
+    if (hovered && ImGui::IsMouseDoubleClicked(0)) {
+        plot_t0 = 0.0;
+        plot_t1 = std::max((double)max_time, 1.0);
+    }
+    else if (active && ImGui::IsMouseDown(0)) {
+        current_time = std::clamp((float)mouse_t, 0.0f, max_time);
+    }
+    span = plot_t1 - plot_t0;
+
+    // Her seri ya sütun başına min/max zarfı (yoğun) ya da tek tek örnekler (seyrek) olarak hazırlanır
+    struct Series {
+        size_t dataset_idx;
+        bool dense;
+        std::vector<float> col_min, col_max;
+        size_t begin = 0, end = 0;
+    };
+    std::vector<Series> series;
+    int width = (int)size.x;
+    float y_min = std::numeric_limits<float>::infinity(), y_max = -std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i < datasets.size(); ++i) {
+        if (!visibility[i] || !update_plot_series(panel.pyramids[i], i, key)) continue;
+        const MinMaxPyramid& pyramid = panel.pyramids[i];
+        Series s;
+        s.dataset_idx = i;
+        s.dense = pyramid.envelope(plot_t0, plot_t1, width, s.col_min, s.col_max);
+        if (s.dense) {
+            for (int c = 0; c < width; ++c) {
+                if (s.col_min[c] > s.col_max[c]) continue;
+                y_min = std::min(y_min, s.col_min[c]);
+                y_max = std::max(y_max, s.col_max[c]);
+            }
+        }
+        else {
+            pyramid.raw_range(plot_t0, plot_t1, s.begin, s.end);
+            const auto& values = pyramid.sample_values();
+            for (size_t k = s.begin; k < s.end; ++k) {
+                y_min = std::min(y_min, values[k]);
+                y_max = std::max(y_max, values[k]);
+            }
+        }
+        series.push_back(std::move(s));
+    }
+    if (!(y_max >= y_min)) { y_min = 0.0f; y_max = 1.0f; }
+    if (y_max - y_min < 1e-6f) { y_min -= 0.5f; y_max += 0.5f; }
+    float margin = (y_max - y_min) * 0.05f;
+    y_min -= margin;
+    y_max += margin;
+
+    ImDrawList* draw = ImGui::GetWindowDrawList();
+    draw->AddRectFilled(origin, corner, IM_COL32(12, 16, 26, 255));
+    draw->PushClipRect(origin, corner, true);
+    auto to_x = [&](double t) { return origin.x + (float)((t - plot_t0) / span * size.x); };
+    auto to_y = [&](float v) { return corner.y - (v - y_min) / (y_max - y_min) * size.y; };
+
+    // Zaman ekseni: yaklaşık 6 aralık olacak şekilde 1-2-5 adımları
+    double step = std::pow(10.0, std::floor(std::log10(span / 6.0)));
+    if (span / step > 30.0) step *= 5.0;
+    else if (span / step > 12.0) step *= 2.0;
+    char label[64];
+    for (double t = std::ceil(plot_t0 / step) * step; t <= plot_t1; t += step) {
+        float x = to_x(t);
+        draw->AddLine(ImVec2(x, origin.y), ImVec2(x, corner.y), IM_COL32(50, 56, 70, 255));
+        snprintf(label, sizeof(label), "%g s", t);
+        draw->AddText(ImVec2(x + 3.0f, corner.y - ImGui::GetTextLineHeight() - 2.0f), IM_COL32(150, 150, 160, 255), label);
+    }
+
+    for (const Series& s : series) {
+        ImU32 color = is_truth_dataset(datasets[s.dataset_idx]) ? truth_color : palette[s.dataset_idx % IM_ARRAYSIZE(palette)];
+        if (s.dense) {
+            // Komşu sütunların aralıkları birbirine uzatılır ki seri kesintisiz görünsün
+            bool has_prev = false;
+            float prev_min = 0.0f, prev_max = 0.0f;
+            for (int c = 0; c < width; ++c) {
+                if (s.col_min[c] > s.col_max[c]) { has_prev = false; continue; }
+                float lo = s.col_min[c], hi = s.col_max[c];
+                if (has_prev) {
+                    lo = std::min(lo, prev_max);
+                    hi = std::max(hi, prev_min);
+                }
+                draw->AddRectFilled(ImVec2(origin.x + c, to_y(hi)), ImVec2(origin.x + c + 1.0f, to_y(lo) + 1.0f), color);
+                prev_min = s.col_min[c];
+                prev_max = s.col_max[c];
+                has_prev = true;
+            }
+        }
+        else {
+            const auto& times = panel.pyramids[s.dataset_idx].sample_times();
+            const auto& values = panel.pyramids[s.dataset_idx].sample_values();
+            std::vector<ImVec2> points;
+            points.reserve(s.end - s.begin);
+            for (size_t k = s.begin; k < s.end; ++k) points.push_back(ImVec2(to_x(times[k]), to_y(values[k])));
+            if (points.size() > 1) draw->AddPolyline(points.data(), (int)points.size(), color, 0, 1.5f);
+            for (const auto& p : points) draw->AddRectFilled(ImVec2(p.x - 1.5f, p.y - 1.5f), ImVec2(p.x + 1.5f, p.y + 1.5f), color);
+        }
+    }
+
+    // Zaman imleci
+    float cursor_x = to_x(current_time);
+    draw->AddLine(ImVec2(cursor_x, origin.y), ImVec2(cursor_x, corner.y), IM_COL32(255, 230, 80, 255), 1.5f);
+
+    // Değer aralığı ve gösterge
+    snprintf(label, sizeof(label), "%s  [%.4g, %.4g]", plot_column_options[panel.column_option].label, y_min + margin, y_max - margin);
+    draw->AddText(ImVec2(origin.x + 4.0f, origin.y + 2.0f), IM_COL32(220, 220, 230, 255), label);
+    float legend_x = corner.x - 4.0f;
+    for (auto it = series.rbegin(); it != series.rend(); ++it) {
+        const std::string& name = datasets[it->dataset_idx].name;
+        legend_x -= ImGui::CalcTextSize(name.c_str()).x + 10.0f;
+        ImU32 color = is_truth_dataset(datasets[it->dataset_idx]) ? truth_color : palette[it->dataset_idx % IM_ARRAYSIZE(palette)];
+        draw->AddText(ImVec2(legend_x, origin.y + 2.0f), color, name.c_str());
+    }
+    draw->PopClipRect();
+
+    if (hovered) ImGui::SetTooltip("t = %.3f s", mouse_t);
+    ImGui::PopID();
+}
+
+void PlotterApp::render_time_series_window() {
+    if (!show_time_series) return;
+    if (plot_panels.empty()) {
+        for (int option : { 0, 1, 2 }) {
+            plot_panels.push_back({});
+            plot_panels.back().column_option = option;
+        }
+    }
+    if (!(plot_t1 > plot_t0)) {
+        plot_t0 = 0.0;
+        plot_t1 = std::max((double)max_time, 1.0);
+    }
+
+    ImGui::SetNextWindowSize(ImVec2(820, 600), ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Zaman Serileri", &show_time_series)) {
+        ImGui::Checkbox("Zamani Takip Et", &plot_follow_time);
+        ImGui::SameLine();
+        if (ImGui::Button("Panel Ekle")) plot_panels.push_back({});
+        if (plot_panels.size() > 1) {
+            ImGui::SameLine();
+            if (ImGui::Button("Panel Sil")) plot_panels.pop_back();
+        }
+        ImGui::SameLine();
+        ImGui::TextDisabled("sol: zaman imleci, sag surukle: kaydir, tekerlek: yakinlastir, cift tik: tumu");
+
+        if (plot_follow_time) {
+            double span = plot_t1 - plot_t0;
+            plot_t0 = current_time - span * 0.5;
+            plot_t1 = plot_t0 + span;
+        }
+        float available = ImGui::GetContentRegionAvail().y;
+        float height = std::max(80.0f, available / plot_panels.size() - ImGui::GetFrameHeightWithSpacing() - 6.0f);
+        for (int i = 0; i < (int)plot_panels.size(); ++i) {
+            render_plot_panel(plot_panels[i], i, height);
+        }
+    }
+    ImGui::End();
+}
+
+void PlotterApp::sort_data_grid() {
+    const auto& ds = datasets[grid_dataset_idx];
+    size_t rows = ds.points.size();
+    grid_order_dataset = grid_dataset_idx;
+    const std::string key = grid_columns[grid_sort_column].key;
+    if (key == "#") {
+        grid_order.identity(rows, grid_sort_descending);
+        return;
+    }
+    if (key == "err_mag") {
+        const auto& table = association(grid_dataset_idx);
+        std::vector<double> magnitudes(std::min(table.residual_ecef.size(), rows), std::numeric_limits<double>::quiet_NaN());
+        for (size_t i = 0; i < magnitudes.size(); ++i) {
+            if (!table.is_valid(i)) continue;
+            const auto& r = table.residual_ecef[i];
+            magnitudes[i] = std::sqrt(r.x * r.x + r.y * r.y + r.z * r.z);
+        }
+        grid_order.sort(magnitudes, rows, grid_sort_descending);
+        return;
+    }
+    const std::vector<double>* column = ds.find_column(key);
+    if (column) grid_order.sort(*column, rows, grid_sort_descending);
+    else grid_order.identity(rows, grid_sort_descending);
+}
+
+void PlotterApp::render_data_grid_window() {
+    if (!show_data_grid || datasets.empty()) return;
+
+    // 3B görünümde başka bir veri setinden nokta seçildiyse tablo o veri setine geçer
+    if (selected_dataset_idx < datasets.size() && selected_point_idx != grid_synced_point && (int)selected_dataset_idx != grid_dataset_idx) {
+        grid_dataset_idx = (int)selected_dataset_idx;
+    }
+
+    ImGui::SetNextWindowSize(ImVec2(900, 500), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Veri Tablosu", &show_data_grid)) {
+        ImGui::End();
+        return;
+    }
+
+    if (ImGui::BeginCombo("Veri Seti##tablo", datasets[grid_dataset_idx].name.c_str())) {
+        for (int n = 0; n < (int)datasets.size(); n++) {
+            if (ImGui::Selectable(datasets[n].name.c_str(), grid_dataset_idx == n)) grid_dataset_idx = n;
+        }
+        ImGui::EndCombo();
+    }
+    const auto& ds = datasets[grid_dataset_idx];
+    const auto& table = association(grid_dataset_idx);
+    size_t rows = ds.points.size();
+    ImGui::SameLine();
+    ImGui::Text("%zu satir", rows);
+    ImGui::SameLine();
+    ImGui::TextDisabled("tik: sec, cift tik: sabitle");
+
+    // Sütunlar kare başına bir kez çözülür; hücreler değerleri doğrudan bu dizilerden okur
+    const int error_column = IM_ARRAYSIZE(grid_columns) - 1;
+    const std::vector<double>* columns[IM_ARRAYSIZE(grid_columns)] = {};
+    for (int c = 1; c < error_column; ++c) columns[c] = ds.find_column(grid_columns[c].key);
+
+    ImGuiTableFlags flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_Sortable | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("veri_tablosu", IM_ARRAYSIZE(grid_columns), flags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        for (int c = 0; c < IM_ARRAYSIZE(grid_columns); ++c) {
+            ImGui::TableSetupColumn(grid_columns[c].label, c == 0 ? ImGuiTableColumnFlags_DefaultSort : ImGuiTableColumnFlags_None, 0.0f, c);
+        }
+        ImGui::TableHeadersRow();
+
+        // Başlığa tıklanınca ya da veri seti/satır sayısı değişince permütasyon yeniden kurulur
+        // Büyüyen veri setlerinde (canlı mod) yeni satırlar en fazla saniyede bir sıralamaya katılır
+        bool resort = grid_order_dataset != (size_t)grid_dataset_idx || (grid_order.size() != rows && ImGui::GetTime() - grid_sorted_at >= 1.0);
+        if (ImGuiTableSortSpecs* specs = ImGui::TableGetSortSpecs(); specs && specs->SpecsDirty) {
+            if (specs->SpecsCount > 0) {
+                grid_sort_column = specs->Specs[0].ColumnUserID;
+                grid_sort_descending = specs->Specs[0].SortDirection == ImGuiSortDirection_Descending;
+            }
+            specs->SpecsDirty = false;
+            resort = true;
+        }
+        if (resort) {
+            sort_data_grid();
+            grid_sorted_at = ImGui::GetTime();
+        }
+
+        // Seçim 3B görünümden değiştiyse seçili satır görünür alana kaydırılır
+        size_t scroll_position = std::numeric_limits<size_t>::max();
+        if ((size_t)grid_dataset_idx == selected_dataset_idx && selected_point_idx != grid_synced_point) {
+            scroll_position = grid_order.position_of(selected_point_idx);
+            grid_synced_point = selected_point_idx;
+        }
+
+        ImGuiListClipper clipper;
+        clipper.Begin((int)grid_order.size());
+        if (scroll_position < grid_order.size()) clipper.IncludeItemByIndex((int)scroll_position);
+        while (clipper.Step()) {
+            for (int position = clipper.DisplayStart; position < clipper.DisplayEnd; ++position) {
+                uint32_t row = grid_order.row(position);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::PushID((int)row);
+                bool is_selected = (size_t)grid_dataset_idx == selected_dataset_idx && row == selected_point_idx;
+                char index_label[32];
+                snprintf(index_label, sizeof(index_label), "%u", row);
+                if (ImGui::Selectable(index_label, is_selected, ImGuiSelectableFlags_SpanAllColumns)) {
+                    // Tablodan yapılan seçim tabloyu kaydırmaz
+                    if (ImGui::IsMouseDoubleClicked(0)) select_and_pin(grid_dataset_idx, row);
+                    else {
+                        selected_dataset_idx = grid_dataset_idx;
+                        selected_point_idx = row;
+                    }
+                    grid_synced_point = row;
+                }
+                if ((size_t)position == scroll_position) ImGui::SetScrollHereY(0.5f);
+                ImGui::PopID();
+
+                for (int c = 1; c < IM_ARRAYSIZE(grid_columns); ++c) {
+                    ImGui::TableNextColumn();
+                    double value = std::numeric_limits<double>::quiet_NaN();
+                    if (columns[c] && row < columns[c]->size()) value = (*columns[c])[row];
+                    else if (c == error_column && table.is_valid(row)) {
+                        const auto& r = table.residual_ecef[row];
+                        value = std::sqrt(r.x * r.x + r.y * r.y + r.z * r.z);
+                    }
+                    if (std::isnan(value)) ImGui::TextDisabled("-");
+                    else ImGui::Text("%.4f", value);
+                }
+            }
+        }
+        clipper.End();
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+void PlotterApp::render_loading_indicator(const ImVec2& viewport_pos, const ImVec2& viewport_size) {
+    if (!is_loading() || datasets.empty()) return;
+    float progress = 0.0f;
+    for (size_t i = 0; i < datasets.size(); ++i) {
+        progress += renderer.upload_progress(i);
+    }
+    progress /= (float)datasets.size();
+
+    ImGui::SetNextWindowPos(ImVec2(viewport_pos.x + 10.0f, viewport_pos.y + viewport_size.y - 10.0f), ImGuiCond_Always, ImVec2(0.0f, 1.0f));
+    ImGui::SetNextWindowBgAlpha(0.6f);
+    ImGui::Begin("Yukleniyor", NULL, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings |
+        ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoInputs);
+    ImGui::Text("Veri setleri yukleniyor... (%zu/%zu hazir)", datasets_prepared, datasets.size());
+    ImGui::ProgressBar(progress, ImVec2(250.0f, 0.0f));
+    ImGui::End();
+}
+
 void PlotterApp::init_window() {
     glfwSetErrorCallback(glfw_error_callback);
     if (!glfwInit()) throw std::runtime_error("GLFW baslatilamadi");
@@ -177,104 +1021,68 @@ void PlotterApp::main_loop() {
         float current_frame_time = (float)glfwGetTime();
         float dt = current_frame_time - last_time;
         last_time = current_frame_time;
+        frame_dt = dt;
+        dt = std::min(dt, 0.1f); // Olay beklemesinden dönüldüğünde oynatma zamanı sıçramasın
 
-        glfwPollEvents();
-        update(dt);
+        // Sahne bir süredir değişmiyorsa ve oynatma yoksa olay gelene kadar beklenir (boşta güç tüketimi)
+        if (!is_playing && idle_frames > 3 && !renderer.has_pending_picks() && !is_loading()) {
+            glfwWaitEventsTimeout(live_active() ? 0.02 : 0.5);
+        }
+        else {
+            glfwPollEvents();
+        }
+        profiler.begin_frame();
+        {
+            ProfileScope scope(profiler, "update");
+            update(dt);
+        }
 
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
 
-        render_ui();
+        {
+            ProfileScope scope(profiler, "render_ui");
+            render_ui();
+        }
 
         ImGui::Render();
         int w, h;
         glfwGetFramebufferSize(window, &w, &h);
         glViewport(0, 0, w, h);
         glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            GpuProfileScope gpu_scope(profiler, "Arayuz");
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
         glfwSwapBuffers(window);
+        profiler.end_frame();
     }
 }
 
 void PlotterApp::update(float dt) {
+    // Yükleyici bu noktadan önce bittiyse ürettiği her şey aşağıdaki poll_loading ile alınmış olur
+    bool loader_done = loading_finished;
+    if (is_loading()) poll_loading();
+    if (loader_done && live_active()) poll_live();
+
     if (is_playing) {
         current_time += dt * playback_speed;
         if (current_time > max_time) current_time = 0; // Başa sar
     }
 
-    size_t truth_idx = find_truth_dataset_idx();
-    if (truth_idx != std::numeric_limits<size_t>::max()) {
-        const auto& truth_ds = datasets[truth_idx];
-        if (truth_ds.points.size() > 1) {
-            auto it = std::lower_bound(truth_ds.time_data.begin(), truth_ds.time_data.end(), current_time);
-            size_t idx1 = std::distance(truth_ds.time_data.begin(), it);
-            if (idx1 == 0) idx1 = 1;
-            if (idx1 >= truth_ds.points.size()) idx1 = truth_ds.points.size() - 1;
-            size_t idx0 = idx1 - 1;
-
-            const auto& p0 = truth_ds.points[idx0];
-            const auto& p1 = truth_ds.points[idx1];
-            double t0 = truth_ds.time_data[idx0];
-            double t1 = truth_ds.time_data[idx1];
-            float factor = (t1 - t0 > 1e-5) ? (float)((current_time - t0) / (t1 - t0)) : 0.0f;
-
-            Math::Vec3 pos = {
-                (float)(p0.x + (p1.x - p0.x) * factor),
-                (float)(p0.z + (p1.z - p0.z) * factor),
-                (float)-(p0.y + (p1.y - p0.y) * factor)
-            };
-
-            Math::Vec3 world_fwd_vec = { (float)(p1.x - p0.x), (float)(p1.z - p0.z), (float)-(p1.y - p0.y) };
-            float len = sqrtf(world_fwd_vec.x * world_fwd_vec.x + world_fwd_vec.y * world_fwd_vec.y + world_fwd_vec.z * world_fwd_vec.z);
-            if (len > 1e-5) {
-                world_fwd_vec.x /= len; world_fwd_vec.y /= len; world_fwd_vec.z /= len;
-            }
-            else {
-                if (idx0 > 0) {
-                    const auto& p_prev = truth_ds.points[idx0 - 1];
-                    world_fwd_vec = { (float)(p0.x - p_prev.x), (float)(p0.z - p_prev.z), (float)-(p0.y - p_prev.y) };
-                    len = sqrtf(world_fwd_vec.x * world_fwd_vec.x + world_fwd_vec.y * world_fwd_vec.y + world_fwd_vec.z * world_fwd_vec.z);
-                    if (len > 1e-5) {
-                        world_fwd_vec.x /= len; world_fwd_vec.y /= len; world_fwd_vec.z /= len;
-                    }
-                    else { world_fwd_vec = { 1,0,0 }; }
-                }
-                else { world_fwd_vec = { 1,0,0 }; }
-            }
-
-            Math::Vec3 global_up = { 0,1,0 };
-            Math::Vec3 world_right_vec = { global_up.y * world_fwd_vec.z - global_up.z * world_fwd_vec.y, global_up.z * world_fwd_vec.x - global_up.x * world_fwd_vec.z, global_up.x * world_fwd_vec.y - global_up.y * world_fwd_vec.x };
-            len = sqrtf(world_right_vec.x * world_right_vec.x + world_right_vec.y * world_right_vec.y + world_right_vec.z * world_right_vec.z);
-            if (len > 1e-5) {
-                world_right_vec.x /= len; world_right_vec.y /= len; world_right_vec.z /= len;
-            }
-            else { world_right_vec = { 0,0,1 }; }
-
-            Math::Vec3 world_up_vec = { world_fwd_vec.y * world_right_vec.z - world_fwd_vec.z * world_right_vec.y, world_fwd_vec.z * world_right_vec.x - world_fwd_vec.x * world_right_vec.z, world_fwd_vec.x * world_right_vec.y - world_fwd_vec.y * world_right_vec.x };
-
-            // Modelin lokal -X ekseni (burnu) -> dünyanın ileri vektörüne
-            // Modelin lokal +Y ekseni (üstü) -> dünyanın yukarı vektörüne
-            // Modelin lokal +Z ekseni (sağ kanat) -> dünyanın sağ vektörüne
-            Math::Mat4 rotation_matrix = Math::identity();
-            // Sütun 0 (Lokal X'in dünya uzayındaki karşılığı)
-            rotation_matrix.m[0] = -world_fwd_vec.x;
-            rotation_matrix.m[1] = -world_fwd_vec.y;
-            rotation_matrix.m[2] = -world_fwd_vec.z;
-            // Sütun 1 (Lokal Y'nin dünya uzayındaki karşılığı)
-            rotation_matrix.m[4] = world_up_vec.x;
-            rotation_matrix.m[5] = world_up_vec.y;
-            rotation_matrix.m[6] = world_up_vec.z;
-            // Sütun 2 (Lokal Z'nin dünya uzayındaki karşılığı)
-            rotation_matrix.m[8] = world_right_vec.x;
-            rotation_matrix.m[9] = world_right_vec.y;
-            rotation_matrix.m[10] = world_right_vec.z;
-
-            // Önce döndür, sonra pozisyona taşı
-            Math::Mat4 translation_matrix = Math::translate(Math::identity(), pos);
-            target_model_matrix = Math::multiply(translation_matrix, rotation_matrix);
-        }
+    // Tüm gerçek veri setlerinin hedefleri çalışma iş parçacığında hesaplanır; girdiler değiştiyse yeni kare istenir.
+    // Sonuç hazır olduğunda (genellikle bir sonraki karede) alınır, matrisler değiştiyse sahne yeniden çizilir.
+    if (frame_inputs_changed || current_time != requested_frame_time || visibility != requested_visibility) {
+        scene_worker.request_frame(current_time, visibility);
+        requested_frame_time = current_time;
+        requested_visibility = visibility;
+        frame_inputs_changed = false;
     }
+    if (scene_worker.acquire_frame() && renderer.update_target_instances(scene_worker.frame().target_matrices)) scene_dirty = true;
+
+    if (scene_worker.acquire_analysis()) apply_analysis();
+    if (pending_column_stats) apply_column_stats();
 }
 
 
@@ -315,23 +1123,23 @@ void PlotterApp::render_ui() {
                 size_t found_idx = find_closest_time_index(selected_dataset_for_search, searchValue);
 
                 if (found_idx != std::numeric_limits<size_t>::max() && std::abs(selected_dataset_for_search.time_data[found_idx] - searchValue) < 0.1) {
-                    selected_dataset_idx = (size_t)search_dataset_idx_int;
-                    selected_point_idx = found_idx;
-                    bool already_pinned = false;
-                    for (const auto& pinned : pinned_points) {
-                        if (pinned.dataset_idx == selected_dataset_idx && pinned.point_idx == selected_point_idx) {
-                            already_pinned = true;
-                            break;
-                        }
-                    }
-                    if (!already_pinned) {
-                        pinned_points.push_back({ next_pin_uid++, selected_dataset_idx, selected_point_idx, true, false });
-                    }
+                    select_and_pin((size_t)search_dataset_idx_int, found_idx);
                 }
                 else { show_search_warning = true; }
             }
             catch (...) { show_search_warning = true; }
         }
+        ImGui::SetNextItemWidth(-260);
+        bool submitted = ImGui::InputText("Sorgu", query_text, IM_ARRAYSIZE(query_text), ImGuiInputTextFlags_EnterReturnsTrue);
+        ImGui::SameLine();
+        if (ImGui::Button("Calistir") || submitted) run_query();
+        ImGui::SameLine();
+        if (ImGui::Button("Temizle")) clear_query();
+        if (!query_matches.empty()) {
+            ImGui::SameLine();
+            if (ImGui::Button("CSV Aktar")) export_query_results("adab_sorgu.csv");
+        }
+        if (!query_message.empty()) ImGui::TextUnformatted(query_message.c_str());
     }
     ImGui::Columns(1);
     ImGui::EndChild();
@@ -347,6 +1155,76 @@ void PlotterApp::render_ui() {
     ImGui::SameLine();
     ImGui::SetNextItemWidth(120);
     ImGui::SliderFloat("Hiz", &playback_speed, 0.1f, 10.0f);
+    ImGui::Checkbox("GPU ile Secim (ID Tamponu)", &use_gpu_picking);
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(140);
+    const char* time_window_modes[] = { "Tumu", "Simdiye Kadar", "Son N Saniye" };
+    ImGui::Combo("Zaman Penceresi", &time_window_mode, time_window_modes, IM_ARRAYSIZE(time_window_modes));
+    if (time_window_mode == TIME_WINDOW_TRAIL) {
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(120);
+        ImGui::SliderFloat("Iz (s)", &trail_seconds, 1.0f, std::max(max_time, 1.0f));
+    }
+    bool style_changed = false;
+    for (int* option : { &point_color_option, &point_size_option }) {
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(150);
+        const char* label = option == &point_color_option ? "Nokta Rengi" : "Nokta Boyutu";
+        if (ImGui::BeginCombo(label, point_attribute_options[*option].label)) {
+            for (int n = 0; n < IM_ARRAYSIZE(point_attribute_options); n++) {
+                if (ImGui::Selectable(point_attribute_options[n].label, *option == n)) {
+                    style_changed |= *option != n;
+                    *option = n;
+                }
+            }
+            ImGui::EndCombo();
+        }
+    }
+    if (style_changed) apply_point_style();
+    ImGui::Checkbox("Dinamik Cozunurluk", &dynamic_resolution);
+    if (dynamic_resolution) {
+        ImGui::SameLine();
+        ImGui::Text("%%%d", (int)(resolution_scale * 100.0f + 0.5f));
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(100);
+    const char* msaa_modes[] = { "Kapali", "2x", "4x", "8x" };
+    ImGui::Combo("MSAA", &msaa_option, msaa_modes, IM_ARRAYSIZE(msaa_modes));
+    ImGui::SameLine();
+    ImGui::Checkbox("Profil", &show_profiler);
+    ImGui::SameLine();
+    ImGui::Checkbox("Grafikler", &show_time_series);
+    ImGui::SameLine();
+    ImGui::Checkbox("Tablo", &show_data_grid);
+    if (live_active()) {
+        ImGui::SameLine();
+        ImGui::Checkbox("Canliyi Takip Et", &live_follow);
+        ImGui::SameLine();
+        ImGui::Text("Canli: %llu ornek, %llu atildi", (unsigned long long)(live_receiver.samples_received() + live_follower.rows_parsed()),
+            (unsigned long long)(live_receiver.samples_dropped() + live_follower.rows_malformed() + live_rejected));
+    }
+    else if (!live_error.empty()) {
+        ImGui::SameLine();
+        ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1), "Canli mod: %s", live_error.c_str());
+    }
+    ImGui::SameLine();
+    if (ImGui::Checkbox("Artik Alani", &show_residual_field) && show_residual_field) {
+        upload_residual_field();
+    }
+    if (show_residual_field) {
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(150);
+        ImGui::SliderFloat("Artik Olcegi", &residual_scale, 1.0f, 1000.0f, "x%.0f", ImGuiSliderFlags_Logarithmic);
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Yogunluk Haritasi", &show_density);
+    if (show_density) {
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(150);
+        ImGui::SliderFloat("Yogunluk Kazanci", &density_gain, 1.0f, 1024.0f, "x%.0f", ImGuiSliderFlags_Logarithmic);
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Ust Gorunum", &top_down_view);
     ImGui::EndChild();
 
     if (show_search_warning) {
@@ -364,52 +1242,106 @@ void PlotterApp::render_ui() {
     ImVec2 viewport_pos = ImGui::GetCursorScreenPos();
     ImVec2 viewport_size = ImGui::GetContentRegionAvail();
 
-    // Çizilecek tüm hata vektörlerini topla
+    // Çizilecek tüm hata vektörlerini eşleşme tablosundan topla
     std::vector<std::pair<DataPoint, DataPoint>> vectors_to_draw;
-    size_t truth_ds_idx = find_truth_dataset_idx();
-    if (truth_ds_idx != std::numeric_limits<size_t>::max()) {
-        const auto& truth_ds = datasets[truth_ds_idx];
-        for (const auto& pinned : pinned_points) {
-            if (pinned.show_error_vector) {
-                const auto& ds = datasets[pinned.dataset_idx];
-                if (ds.name.find("Radar") != std::string::npos) {
-                    double measurement_time = ds.time_data[pinned.point_idx];
-                    size_t truth_idx = find_closest_time_index(truth_ds, measurement_time);
-                    if (truth_idx != std::numeric_limits<size_t>::max()) {
-                        vectors_to_draw.push_back({ ds.points[pinned.point_idx], truth_ds.points[truth_idx] });
-                    }
-                }
-            }
+    for (const auto& pinned : pinned_points) {
+        if (!pinned.show_error_vector) continue;
+        const auto& table = association(pinned.dataset_idx);
+        if (table.is_valid(pinned.point_idx)) {
+            vectors_to_draw.push_back({ datasets[pinned.dataset_idx].points[pinned.point_idx], table.truth_points[pinned.point_idx] });
         }
     }
-    renderer.update_error_vectors(vectors_to_draw);
+    if (renderer.update_error_vectors(vectors_to_draw)) scene_dirty = true;
+
+    // FBO'yu görüntü alanının (ölçeklenmiş) piksel boyutuna getir
+    update_resolution_scale();
+    if (viewport_size.x >= 1.0f && viewport_size.y >= 1.0f) {
+        int fbo_w = (int)(viewport_size.x * resolution_scale + 0.5f);
+        int fbo_h = (int)(viewport_size.y * resolution_scale + 0.5f);
+        if (renderer.resize_fbo(fbo_w, fbo_h, 1 << msaa_option)) scene_dirty = true;
+    }
 
-    render_scene();
+    bool redraw = viewport_size.x >= 1.0f && viewport_size.y >= 1.0f && scene_needs_redraw();
+    if (redraw) {
+        ProfileScope scope(profiler, "render_scene");
+        render_scene(viewport_size);
+        idle_frames = 0;
+    }
+    else {
+        idle_frames++;
+    }
 
     ImGui::SetCursorScreenPos(viewport_pos);
     ImGui::Image((void*)(intptr_t)renderer.get_fbo_texture(), viewport_size, ImVec2(0, 1), ImVec2(1, 0));
 
-    handle_input(viewport_pos, viewport_size);
+    {
+        ProfileScope scope(profiler, "handle_input");
+        handle_input(viewport_pos, viewport_size);
+    }
 
     render_pinned_point_windows(viewport_pos, viewport_size);
+    render_loading_indicator(viewport_pos, viewport_size);
+    render_profiler_window();
+    render_time_series_window();
+    render_data_grid_window();
 
     ImGui::End();
+    redrew_last_frame = redraw;
+}
+
+void PlotterApp::update_resolution_scale() {
+    if (!dynamic_resolution) {
+        if (resolution_scale != 1.0f) scene_dirty = true;
+        resolution_scale = 1.0f;
+        slow_frames = fast_frames = 0;
+        return;
+    }
+    // Yalnızca art arda yeniden çizilen karelerin süresi sahne maliyetini yansıtır (boşta beklemeler hariç)
+    if (!redrew_last_frame || idle_frames > 0) return;
+
+    constexpr float frame_budget = 1.0f / 30.0f;
+    constexpr int hysteresis_frames = 30;
+    constexpr float scale_step = 0.125f;
+    if (frame_dt > frame_budget) { slow_frames++; fast_frames = 0; }
+    else if (frame_dt < frame_budget * 0.6f) { fast_frames++; slow_frames = 0; }
+    else { slow_frames = fast_frames = 0; }
+
+    float new_scale = resolution_scale;
+    if (slow_frames >= hysteresis_frames) new_scale = std::max(0.5f, resolution_scale - scale_step);
+    else if (fast_frames >= hysteresis_frames) new_scale = std::min(1.0f, resolution_scale + scale_step);
+    if (new_scale != resolution_scale) {
+        resolution_scale = new_scale;
+        slow_frames = fast_frames = 0;
+    }
 }
 
-void PlotterApp::render_scene() {
+void PlotterApp::render_scene(const ImVec2& viewport_size) {
     renderer.bind_fbo();
-    glViewport(0, 0, 1920, 1080);
-    glClearColor(0.01f, 0.02f, 0.05f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    renderer.clear_fbo(0.01f, 0.02f, 0.05f);
     glEnable(GL_DEPTH_TEST);
 
-    projection_matrix = Math::perspective(45.0f * (float)std::numbers::pi / 180.0f, 1920.f / 1080.f, 1.0f, grid_size * 5.0f);
-    Math::Vec3 eye = {
-        cam_center.x + cam_distance * cosf(cam_pitch) * sinf(cam_yaw),
-        cam_center.y + cam_distance * sinf(cam_pitch),
-        cam_center.z + cam_distance * cosf(cam_pitch) * cosf(cam_yaw)
-    };
-    view_matrix = Math::lookAt(eye, cam_center, { 0,1,0 });
+    // En-boy oranı FBO'dan değil görüntü alanından alınır; ölçekli FBO aynı görüntüyü daha az pikselle çizer
+    float aspect = viewport_size.x / viewport_size.y;
+    float fov = 45.0f * (float)std::numbers::pi / 180.0f;
+    Math::Vec3 eye;
+    // Seçim küresinin ekrandaki boyutunu sabit tutmak için dünya biriminin görüş yüksekliğine oranı
+    float half_height = 0.0f;
+    if (top_down_view) {
+        // Yukarıdan ortografik görünüm: yaw ekranın yukarı yönünü, uzaklık görülen alanı belirler
+        half_height = cam_distance * tanf(fov * 0.5f);
+        projection_matrix = Math::orthographic(-half_height * aspect, half_height * aspect, -half_height, half_height, 1.0f, grid_size * 5.0f);
+        eye = { cam_center.x, cam_center.y + grid_size * 2.0f, cam_center.z };
+        view_matrix = Math::lookAt(eye, cam_center, { -sinf(cam_yaw), 0.0f, -cosf(cam_yaw) });
+    }
+    else {
+        projection_matrix = Math::perspective(fov, aspect, 1.0f, grid_size * 5.0f);
+        eye = {
+            cam_center.x + cam_distance * cosf(cam_pitch) * sinf(cam_yaw),
+            cam_center.y + cam_distance * sinf(cam_pitch),
+            cam_center.z + cam_distance * cosf(cam_pitch) * cosf(cam_yaw)
+        };
+        view_matrix = Math::lookAt(eye, cam_center, { 0,1,0 });
+    }
 
     Math::Mat4 selection_sphere_model = {};
     if (selected_dataset_idx != std::numeric_limits<size_t>::max() && selected_point_idx != std::numeric_limits<size_t>::max()) {
@@ -423,54 +1355,50 @@ void PlotterApp::render_scene() {
         float dist_to_point = sqrtf(dx * dx + dy * dy + dz * dz);
         if (dist_to_point < 1.0f) dist_to_point = 1.0f;
 
-        float sphere_scale = dist_to_point * 0.004f;
+        float sphere_scale = top_down_view ? half_height * 0.01f : dist_to_point * 0.004f;
         selection_sphere_model = Math::scale(point_model, { sphere_scale, sphere_scale, sphere_scale });
     }
 
-    renderer.draw(view_matrix, projection_matrix, visibility, radar_model_matrix, target_model_matrix, selection_sphere_model);
+    float t_start = 0.0f, t_end = 0.0f;
+    bool windowed = time_window(t_start, t_end);
+    renderer.set_time_window(windowed, t_start, t_end, time_window_mode == TIME_WINDOW_TRAIL);
+    renderer.set_residual_field(show_residual_field, residual_scale);
+    renderer.set_density_mode(show_density, density_gain);
+    renderer.draw(view_matrix, projection_matrix, visibility, radar_model_matrix, selection_sphere_model);
 
     renderer.unbind_fbo();
 }
 
 void PlotterApp::handle_input(const ImVec2& viewport_pos, const ImVec2& viewport_size) {
+    process_gpu_picks();
+
     if (ImGui::IsItemHovered()) {
         ImGuiIO& io = ImGui::GetIO();
 
+        // Fare konumunun FBO pikseline karşılığı (görüntü dikeyde ters çevrilerek çiziliyor)
+        float fbo_scale_x = renderer.get_fbo_width() / viewport_size.x;
+        float fbo_scale_y = renderer.get_fbo_height() / viewport_size.y;
+        int fbo_x = (int)((io.MousePos.x - viewport_pos.x) * fbo_scale_x);
+        int fbo_y = (int)((viewport_size.y - (io.MousePos.y - viewport_pos.y)) * fbo_scale_y);
+        int fbo_radius = (int)(15.0f * std::max(fbo_scale_x, fbo_scale_y));
+
         if (ImGui::IsMouseClicked(0) && !ImGui::IsMouseDragging(0)) {
-            size_t closest_ds_idx = std::numeric_limits<size_t>::max();
-            size_t closest_pt_idx = std::numeric_limits<size_t>::max();
-            float min_dist_sq = 15.0f * 15.0f;
-
-            for (size_t i = 0; i < datasets.size(); ++i) {
-                if (!visibility[i]) continue;
-                for (size_t j = 0; j < datasets[i].points.size(); ++j) {
-                    const auto& p = datasets[i].points[j];
-                    Math::Vec3 screen_pos_3d;
-                    if (Math::project({ (float)p.x, (float)p.z, (float)-p.y }, view_matrix, projection_matrix, (int)viewport_size.x, (int)viewport_size.y, screen_pos_3d)) {
-                        float dx = io.MousePos.x - (screen_pos_3d.x + viewport_pos.x);
-                        float dy = io.MousePos.y - (screen_pos_3d.y + viewport_pos.y);
-                        if ((dx * dx + dy * dy) < min_dist_sq) {
-                            min_dist_sq = dx * dx + dy * dy;
-                            closest_ds_idx = i;
-                            closest_pt_idx = j;
-                        }
-                    }
-                }
+            if (use_gpu_picking) {
+                renderer.request_pick(fbo_x, fbo_y, fbo_radius, PICK_TAG_CLICK);
+            }
+            else {
+                pick_point_cpu(viewport_pos, viewport_size);
             }
-            selected_dataset_idx = closest_ds_idx;
-            selected_point_idx = closest_pt_idx;
+        }
 
-            if (selected_dataset_idx != std::numeric_limits<size_t>::max()) {
-                bool already_pinned = false;
-                for (const auto& pinned : pinned_points) {
-                    if (pinned.dataset_idx == selected_dataset_idx && pinned.point_idx == selected_point_idx) {
-                        already_pinned = true;
-                        break;
-                    }
-                }
-                if (!already_pinned) {
-                    pinned_points.push_back({ next_pin_uid++, selected_dataset_idx, selected_point_idx, true, false });
-                }
+        if (use_gpu_picking && !ImGui::IsMouseDragging(0) && !ImGui::IsMouseDragging(1)) {
+            if (!hover_pick_in_flight) {
+                hover_pick_in_flight = renderer.request_pick(fbo_x, fbo_y, fbo_radius, PICK_TAG_HOVER);
+            }
+            if (hover_dataset_idx < datasets.size() && hover_point_idx < datasets[hover_dataset_idx].points.size()) {
+                const auto& ds = datasets[hover_dataset_idx];
+                ImGui::SetTooltip("%s\nZaman : %.4f s\nX : %.4f m\nY : %.4f m\nZ : %.4f m", ds.name.c_str(),
+                    ds.time_data[hover_point_idx], ds.x_data[hover_point_idx], ds.y_data[hover_point_idx], ds.z_data[hover_point_idx]);
             }
         }
 
@@ -496,11 +1424,77 @@ void PlotterApp::handle_input(const ImVec2& viewport_pos, const ImVec2& viewport
 }
 
 
-size_t PlotterApp::find_truth_dataset_idx() {
+void PlotterApp::pick_point_cpu(const ImVec2& viewport_pos, const ImVec2& viewport_size) {
+    ImGuiIO& io = ImGui::GetIO();
+    size_t closest_ds_idx = std::numeric_limits<size_t>::max();
+    size_t closest_pt_idx = std::numeric_limits<size_t>::max();
+    float min_dist_sq = 15.0f * 15.0f;
+
+    PickQuery query;
+    query.viewport_width = (int)viewport_size.x;
+    query.viewport_height = (int)viewport_size.y;
+    query.mouse_x = io.MousePos.x - viewport_pos.x;
+    query.mouse_y = io.MousePos.y - viewport_pos.y;
+    query.view_proj = Math::multiply(projection_matrix, view_matrix);
+    query.pixel_slope = std::max(2.0f / (projection_matrix.m[0] * viewport_size.x), 2.0f / (projection_matrix.m[5] * viewport_size.y));
+    Math::screen_ray(query.mouse_x, query.mouse_y, view_matrix, projection_matrix, query.viewport_width, query.viewport_height, query.ray_origin, query.ray_direction);
+    if (Math::is_orthographic(projection_matrix)) {
+        // BVH budaması açısal bir koni kullanır. Ortografik ışının başlangıcı sahnenin çok gerisine alınınca koni
+        // piksel silindirine yaklaşır; piksel eğimi de dünya birimi/piksel değerinin bu uzaklığa oranı olur.
+        float back = 200.0f / std::fabs(projection_matrix.m[10]);
+        query.ray_origin.x -= query.ray_direction.x * back;
+        query.ray_origin.y -= query.ray_direction.y * back;
+        query.ray_origin.z -= query.ray_direction.z * back;
+        query.pixel_slope /= back;
+    }
+
+    // Zaman penceresi dışındaki (çizilmeyen) noktalar seçilemez
+    float t_start = 0.0f, t_end = 0.0f;
+    bool windowed = time_window(t_start, t_end);
     for (size_t i = 0; i < datasets.size(); ++i) {
-        if (datasets[i].name.find("Gercek") != std::string::npos) return i;
+        if (!visibility[i]) continue;
+        const auto& times = datasets[i].time_data;
+        std::function<bool(size_t)> in_window;
+        if (windowed && times.size() == datasets[i].points.size()) {
+            in_window = [&](size_t p) { return times[p] >= t_start && times[p] <= t_end; };
+        }
+        if (!pick_indices[i]) continue;
+        size_t pt_idx = pick_indices[i]->pick(query, min_dist_sq, in_window);
+        if (pt_idx != PointBVH::npos) {
+            closest_ds_idx = i;
+            closest_pt_idx = pt_idx;
+        }
+    }
+    select_and_pin(closest_ds_idx, closest_pt_idx);
+}
+
+void PlotterApp::process_gpu_picks() {
+    GpuPickResult result;
+    while (renderer.poll_pick(result)) {
+        bool valid = result.dataset_idx < datasets.size() && result.point_idx < datasets[result.dataset_idx].points.size();
+        if (!valid) {
+            result.dataset_idx = result.point_idx = std::numeric_limits<size_t>::max();
+        }
+        if (result.tag == PICK_TAG_CLICK) {
+            select_and_pin(result.dataset_idx, result.point_idx);
+        }
+        else if (result.tag == PICK_TAG_HOVER) {
+            hover_pick_in_flight = false;
+            hover_dataset_idx = result.dataset_idx;
+            hover_point_idx = result.point_idx;
+        }
     }
-    return std::numeric_limits<size_t>::max();
+}
+
+void PlotterApp::select_and_pin(size_t dataset_idx, size_t point_idx) {
+    selected_dataset_idx = dataset_idx;
+    selected_point_idx = point_idx;
+    if (selected_dataset_idx == std::numeric_limits<size_t>::max()) return;
+
+    for (const auto& pinned : pinned_points) {
+        if (pinned.dataset_idx == selected_dataset_idx && pinned.point_idx == selected_point_idx) return;
+    }
+    pinned_points.push_back({ next_pin_uid++, selected_dataset_idx, selected_point_idx, true, false });
 }
 
 size_t PlotterApp::find_closest_time_index(const SearchableDataset& ds, double time) {
@@ -515,6 +1509,162 @@ size_t PlotterApp::find_closest_time_index(const SearchableDataset& ds, double t
     return idx;
 }
 
+bool PlotterApp::scene_needs_redraw() {
+    SceneState state = {
+        cam_yaw, cam_pitch, cam_distance,
+        cam_center.x, cam_center.y, cam_center.z,
+        current_time,
+        time_window_mode,
+        trail_seconds,
+        selected_dataset_idx, selected_point_idx,
+        show_residual_field, residual_scale,
+        show_density, density_gain,
+        top_down_view,
+    };
+    if (!scene_dirty && state == last_scene_state && visibility == last_visibility) return false;
+    last_scene_state = state;
+    last_visibility = visibility;
+    scene_dirty = false;
+    return true;
+}
+
+void PlotterApp::run_query() {
+    // Değerlendirme analiz iş parçacığında yapılır, sonuç apply_analysis ile uygulanır
+    scene_worker.request_query(query_text);
+    query_message = "Sorgu calisiyor...";
+}
+
+void PlotterApp::clear_query() {
+    for (size_t i = 0; i < query_matches.size(); ++i) renderer.set_highlight(i, {});
+    query_matches.clear();
+    query_columns.clear();
+    query_message.clear();
+    scene_dirty = true;
+}
+
+void PlotterApp::export_query_results(const std::string& path) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        query_message = "Dosya yazilamadi: " + path;
+        return;
+    }
+    // Saklanan sütunlar ve sorguda geçen türetilmiş sütunlar; veri setinde olmayan sütunlar boş bırakılır
+    std::vector<std::string> columns = { "t", "x", "y", "z", "range", "bearing", "elevation" };
+    for (const auto& name : query_columns) {
+        if (std::find(columns.begin(), columns.end(), name) == columns.end()) columns.push_back(name);
+    }
+    out << "veri_seti,indeks";
+    for (const auto& name : columns) out << "," << name;
+    out << "\n" << std::setprecision(12);
+
+    size_t rows = 0;
+    std::vector<const std::vector<double>*> values(columns.size());
+    for (size_t i = 0; i < query_matches.size(); ++i) {
+        if (query_matches[i].empty()) continue;
+        for (size_t c = 0; c < columns.size(); ++c) values[c] = datasets[i].find_column(columns[c]);
+        for (uint32_t row : query_matches[i]) {
+            out << datasets[i].name << "," << row;
+            for (const auto* column : values) {
+                out << ",";
+                if (column && row < column->size()) out << (*column)[row];
+            }
+            out << "\n";
+        }
+        rows += query_matches[i].size();
+    }
+    query_message = std::to_string(rows) + " satir yazildi: " + path;
+}
+
+bool PlotterApp::time_window(float& t_start, float& t_end) const {
+    switch (time_window_mode) {
+    case TIME_WINDOW_UNTIL_NOW:
+        t_start = -std::numeric_limits<float>::max();
+        t_end = current_time;
+        return true;
+    case TIME_WINDOW_TRAIL:
+        t_start = current_time - trail_seconds;
+        t_end = current_time;
+        return true;
+    default:
+        return false;
+    }
+}
+
+void PlotterApp::upload_residual_field() {
+    // Eşleşme tabloları henüz hazır değilse boş tablolar atlanır; tablolar gelince yeniden çağrılır
+    for (size_t i = 0; i < datasets.size(); ++i) {
+        size_t first_changed = i < residual_changed_from.size() ? residual_changed_from[i] : SIZE_MAX;
+        renderer.upload_residual_field(i, datasets[i], association(i), first_changed);
+    }
+    residual_changed_from.assign(datasets.size(), SIZE_MAX);
+    scene_dirty = true;
+}
+
+bool PlotterApp::point_attribute_values(size_t dataset_idx, const std::string& key, std::vector<float>& values, float& vmin, float& vmax) {
+    const auto& ds = datasets[dataset_idx];
+    values.clear();
+    if (key == "err_mag") {
+        // Eşleşmesi olmayan ölçümler NaN kalır ve gri çizilir
+        const auto& table = association(dataset_idx);
+        if (table.empty()) return false;
+        values.resize(table.residual_ecef.size());
+        vmin = 0.0f;
+        vmax = 0.0f;
+        for (size_t i = 0; i < values.size(); ++i) {
+            const auto& r = table.residual_ecef[i];
+            values[i] = (float)std::sqrt(r.x * r.x + r.y * r.y + r.z * r.z);
+            if (values[i] > vmax) vmax = values[i];
+        }
+        return true;
+    }
+
+    const std::vector<double>* column = ds.find_column(key);
+    if (!column || column->size() != ds.points.size()) return false;
+    values.assign(column->begin(), column->end());
+    if (const ColumnStats* st = ds.stats(key); st && st->count > 0) {
+        vmin = (float)st->min;
+        vmax = (float)st->max;
+    }
+    else {
+        auto [mn, mx] = std::minmax_element(column->begin(), column->end());
+        vmin = (float)*mn;
+        vmax = (float)*mx;
+    }
+    return true;
+}
+
+void PlotterApp::apply_point_style() {
+    const std::string color_key = point_attribute_options[point_color_option].key;
+    const std::string size_key = point_attribute_options[point_size_option].key;
+    std::vector<float> values;
+    for (size_t i = 0; i < datasets.size(); ++i) {
+        if (datasets[i].is_line_series) continue;
+        PointStyle style;
+        // Öznitelik akışları ilk seçildiklerinde bir kez yüklenir; sonraki geçişler yalnızca işaretçiyi değiştirir
+        for (const std::string* key : { &color_key, &size_key }) {
+            if (key->empty()) continue;
+            float vmin = 0.0f, vmax = 1.0f;
+            if (!renderer.point_attribute_range(i, *key, vmin, vmax)) {
+                if (!point_attribute_values(i, *key, values, vmin, vmax)) continue;
+                renderer.upload_point_attribute(i, *key, values, vmin, vmax);
+            }
+            if (key == &color_key) {
+                style.color_attribute = *key;
+                style.color_min = vmin;
+                style.color_max = vmax;
+            }
+            else {
+                style.size_attribute = *key;
+                style.size_min = vmin;
+                style.size_max = vmax;
+                style.point_size_min_px = 3.0f;
+            }
+        }
+        renderer.set_point_style(i, style);
+    }
+    scene_dirty = true;
+}
+
 void PlotterApp::render_pinned_point_windows(const ImVec2& viewport_pos, const ImVec2& viewport_size) {
     for (size_t i = 0; i < pinned_points.size(); ) {
         auto& pinned = pinned_points[i];
@@ -537,9 +1687,14 @@ void PlotterApp::render_pinned_point_windows(const ImVec2& viewport_pos, const I
                 ImGui::Text("Z : %.4f m", ds.z_data[pinned.point_idx]);
             }
             else {
-                ImGui::Text("Menzil : %.4f m", ds.range_data[pinned.point_idx]);
-                ImGui::Text("Yanca : %.4f deg", ds.bearing_data[pinned.point_idx]);
-                ImGui::Text("Yukselis: %.4f deg", ds.elevation_data[pinned.point_idx]);
+                const std::vector<double>* range = ds.find_column("range");
+                const std::vector<double>* bearing = ds.find_column("bearing");
+                const std::vector<double>* elevation = ds.find_column("elevation");
+                if (range && bearing && elevation) {
+                    ImGui::Text("Menzil : %.4f m", (*range)[pinned.point_idx]);
+                    ImGui::Text("Yanca : %.4f deg", (*bearing)[pinned.point_idx]);
+                    ImGui::Text("Yukselis: %.4f deg", (*elevation)[pinned.point_idx]);
+                }
             }
             if (ds.has_rbe_capability) {
                 ImGui::Separator();
@@ -547,9 +1702,15 @@ void PlotterApp::render_pinned_point_windows(const ImVec2& viewport_pos, const I
                     pinned.show_ecef = !pinned.show_ecef;
                 }
             }
-            size_t truth_ds_idx = find_truth_dataset_idx();
-            if (ds.name.find("Radar") != std::string::npos && truth_ds_idx != std::numeric_limits<size_t>::max()) {
+            const auto& table = association(pinned.dataset_idx);
+            if (table.is_valid(pinned.point_idx)) {
                 ImGui::Separator();
+                const auto& err = table.residual_ecef[pinned.point_idx];
+                ImGui::Text("Hata (ECEF) : %.2f, %.2f, %.2f m", err.x, err.y, err.z);
+                if (table.has_rbe) {
+                    const auto& err_rbe = table.residual_rbe[pinned.point_idx];
+                    ImGui::Text("Hata (RBE) : %.2f m, %.4f, %.4f deg", err_rbe.x, err_rbe.y, err_rbe.z);
+                }
                 if (ImGui::Button("Hata Vektorunu Goster/Gizle")) {
                     pinned.show_error_vector = !pinned.show_error_vector;
                 }
@@ -577,9 +1738,9 @@ void PlotterApp::shutdown() {
 }
 
 // Ana Başlatıcı Fonksiyon
-void launchInteractivePlotter(const std::vector<SearchableDataset>& datasets, const DataPoint& radar_pos_relative) {
+void launchInteractivePlotter(std::vector<SearchableDataset> datasets, const DataPoint& radar_pos_relative, const LiveConfig& live) {
     try {
-        PlotterApp app(datasets, radar_pos_relative);
+        PlotterApp app(std::move(datasets), radar_pos_relative, live);
         app.run();
     }
     catch (const std::exception& e) {
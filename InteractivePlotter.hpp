@@ -1,7 +1,8 @@
 #pragma once
 #include "DataStructures.hpp"
+#include "LiveIngest.hpp"
 #include <vector>
 
-// Ana Plotter başlatıcı fonksiyonu
-void launchInteractivePlotter(const std::vector<SearchableDataset>& datasets, const DataPoint& radar_pos_relative);
+// Ana Plotter başlatıcı fonksiyonu. live etkinse veri setleri localhost UDP'den gelen örneklerle yerinde büyür.
+void launchInteractivePlotter(std::vector<SearchableDataset> datasets, const DataPoint& radar_pos_relative, const LiveConfig& live = {});
 
@@ -0,0 +1,297 @@
+#include "LiveIngest.hpp"
+#include "Coords.hpp"
+#include <chrono>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
+namespace {
+#ifdef _WIN32
+    using native_socket = SOCKET;
+    const native_socket invalid_socket = INVALID_SOCKET;
+    void close_socket(native_socket s) { closesocket(s); }
+#else
+    using native_socket = int;
+    const native_socket invalid_socket = -1;
+    void close_socket(native_socket s) { close(s); }
+#endif
+
+    // Kayıt alanları sırayla okunur (yapının bellek yerleşimine güvenilmez)
+    LiveSample decode_record(const unsigned char* data) {
+        LiveSample sample;
+        std::memcpy(&sample.stream, data, 4);
+        std::memcpy(&sample.flags, data + 4, 4);
+        std::memcpy(&sample.time, data + 8, 8);
+        std::memcpy(sample.v, data + 16, 24);
+        return sample;
+    }
+}
+
+bool LiveReceiver::start(uint16_t port, std::string& error) {
+    stop();
+#ifdef _WIN32
+    WSADATA wsa_data;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
+        error = "Winsock baslatilamadi";
+        return false;
+    }
+#endif
+    native_socket s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == invalid_socket) {
+        error = "UDP soketi acilamadi";
+        return false;
+    }
+
+    // Alım zaman aşımı, iş parçacığının durdurma isteğini ve bekleyen yığını kısa aralıklarla kontrol etmesini sağlar
+#ifdef _WIN32
+    DWORD timeout = receive_timeout_ms;
+#else
+    timeval timeout = { 0, receive_timeout_ms * 1000 };
+#endif
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof(timeout));
+    int buffer_size = 8 * 1024 * 1024;
+    setsockopt(s, SOL_SOCKET, SO_RCVBUF, (const char*)&buffer_size, sizeof(buffer_size));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(s, (const sockaddr*)&address, sizeof(address)) != 0) {
+        close_socket(s);
+        error = "UDP portu " + std::to_string(port) + " baglanamadi";
+        return false;
+    }
+
+    socket_handle = (intptr_t)s;
+    stop_requested = false;
+    thread = std::thread([this]() { receive_loop(); });
+    return true;
+}
+
+void LiveReceiver::stop() {
+    if (!thread.joinable()) return;
+    stop_requested = true;
+    thread.join();
+    close_socket((native_socket)socket_handle);
+    socket_handle = -1;
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+void LiveReceiver::receive_loop() {
+    native_socket s = (native_socket)socket_handle;
+    std::vector<unsigned char> datagram(64 * 1024);
+    std::vector<LiveSample> pending;
+    auto pending_since = std::chrono::steady_clock::now();
+
+    while (!stop_requested) {
+        int received = (int)recv(s, (char*)datagram.data(), (int)datagram.size(), 0);
+        if (received > 0) {
+            datagrams++;
+            if (received % live_record_size != 0) {
+                dropped++;
+                continue;
+            }
+            size_t count = received / live_record_size;
+            if (pending.size() + count > max_pending_samples) {
+                dropped += count;
+                continue;
+            }
+            if (pending.empty()) pending_since = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < count; ++i) pending.push_back(decode_record(datagram.data() + i * live_record_size));
+            samples += count;
+            // Yoğun akışta yığınlar dolunca ya da birkaç milisaniyede bir gönderilir
+            if (pending.size() < batch_samples && std::chrono::steady_clock::now() - pending_since < std::chrono::milliseconds(receive_timeout_ms)) continue;
+        }
+        // Zaman aşımı (soket sessiz) veya yığın doldu: kuyruğa verilir; kuyruk doluysa sonraki denemeye kadar bekler
+        if (!pending.empty() && queue.try_push(std::move(pending))) {
+            pending = {};
+            pending.reserve(batch_samples);
+        }
+    }
+}
+
+bool RecordingFollower::start(const std::string& file_path, uint32_t stream_idx, const DataPoint& lla, std::string& error) {
+    stop();
+    if (!std::ifstream(file_path, std::ios::binary).is_open()) {
+        error = "Kayit dosyasi acilamadi: " + file_path;
+        return false;
+    }
+    path = file_path;
+    stream = stream_idx;
+    origin_lla = lla;
+    origin_ecef = Coords::lla_to_ecef(lla.x, lla.y, lla.z);
+    stop_requested = false;
+    thread = std::thread([this]() { follow_loop(); });
+    return true;
+}
+
+void RecordingFollower::stop() {
+    if (!thread.joinable()) return;
+    stop_requested = true;
+    thread.join();
+}
+
+void RecordingFollower::push_batch(std::vector<LiveSample>& batch) {
+    while (!stop_requested && !queue.try_push(std::move(batch))) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    batch.clear();
+}
+
+size_t RecordingFollower::parse_rows(const char* text, size_t size, bool at_file_start, std::vector<LiveSample>& batch) {
+    size_t pos = 0;
+    while (const char* line_end = (const char*)std::memchr(text + pos, '\n', size - pos)) {
+        const char* p = text + pos;
+        const char* end = line_end;
+        if (end > p && end[-1] == '\r') end--;
+        bool first_line = at_file_start && pos == 0;
+        pos = line_end - text + 1;
+        if (p == end) continue;
+
+        // Sütunlar: time, posX, velX, accX, posY, velY, accY, posZ, ... (yalnızca ilk sekizi gerekir)
+        double fields[8];
+        int count = 0;
+        while (count < 8) {
+            auto [ptr, ec] = std::from_chars(p, end, fields[count]);
+            if (ec != std::errc()) break;
+            count++;
+            p = ptr;
+            if (p == end || *p != ',') break;
+            p++;
+        }
+        if (count < 8) {
+            // Sayı içermeyen ilk satır başlıktır
+            if (!first_line) malformed++;
+            continue;
+        }
+        DataPoint offset = Coords::ned_to_ecef_offset(origin_lla, fields[1], fields[4], -fields[7]);
+        batch.push_back({ stream, 0, fields[0], { origin_ecef.x + offset.x, origin_ecef.y + offset.y, origin_ecef.z + offset.z } });
+        rows++;
+    }
+    return pos;
+}
+
+void RecordingFollower::follow_loop() {
+#ifdef __linux__
+    int notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (notify_fd >= 0 && inotify_add_watch(notify_fd, path.c_str(), IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB) < 0) {
+        close(notify_fd);
+        notify_fd = -1;
+    }
+#endif
+    std::ifstream file;
+    uint64_t offset = 0;        // Dosyadan okunan bayt sayısı
+    std::string carry;          // Okunmuş ama henüz tamamlanmamış satır(lar)
+    std::vector<char> chunk(read_chunk_bytes);
+    std::vector<LiveSample> batch;
+
+    while (!stop_requested) {
+        std::error_code ec;
+        uint64_t size = std::filesystem::file_size(path, ec);
+        if (!ec && size < offset) {
+            offset = 0;
+            carry.clear();
+            file.close();
+        }
+        if (!ec && size > offset) {
+            if (!file.is_open()) file.open(path, std::ios::binary);
+            file.clear();
+            file.seekg((std::streamoff)offset);
+            file.read(chunk.data(), (std::streamsize)std::min<uint64_t>(size - offset, read_chunk_bytes));
+            size_t got = (size_t)file.gcount();
+            if (got > 0) {
+                bool at_file_start = offset == carry.size();
+                carry.append(chunk.data(), got);
+                offset += got;
+                carry.erase(0, parse_rows(carry.data(), carry.size(), at_file_start, batch));
+                // Satır sonu hiç gelmeyen bozuk veri belleği doldurmasın
+                if (carry.size() > read_chunk_bytes) {
+                    carry.clear();
+                    malformed++;
+                }
+                if (!batch.empty()) push_batch(batch);
+                continue;   // Okunacak veri kalmış olabilir, beklemeden devam edilir
+            }
+        }
+
+        // Dosyaya ekleme yapılana kadar beklenir; inotify yoksa (veya dosya değiştirildiyse) yoklama aralığı yeterlidir
+#ifdef __linux__
+        if (notify_fd >= 0) {
+            pollfd pfd = { notify_fd, POLLIN, 0 };
+            if (poll(&pfd, 1, poll_interval_ms) > 0) {
+                char events[4096];
+                while (read(notify_fd, events, sizeof(events)) > 0) {}
+            }
+            continue;
+        }
+#endif
+        std::this_thread::sleep_for(std::chrono::milliseconds(poll_interval_ms));
+    }
+#ifdef __linux__
+    if (notify_fd >= 0) close(notify_fd);
+#endif
+}
+
+size_t appendLiveSamples(std::vector<SearchableDataset>& datasets, const LiveConfig& config, const std::vector<LiveSample>& batch, std::vector<bool>& touched) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    touched.resize(datasets.size(), false);
+    size_t rejected = 0;
+    for (const LiveSample& sample : batch) {
+        if (sample.stream >= config.stream_datasets.size() || config.stream_datasets[sample.stream] >= datasets.size()) {
+            rejected++;
+            continue;
+        }
+        size_t idx = config.stream_datasets[sample.stream];
+        SearchableDataset& ds = datasets[idx];
+        // Zaman sırası bozulursa enterpolasyon ve zaman aramaları geçersiz olur
+        if (!std::isfinite(sample.time) || (!ds.time_data.empty() && sample.time < ds.time_data.back())) {
+            rejected++;
+            continue;
+        }
+
+        bool is_rbe = (sample.flags & LIVE_SAMPLE_RBE) != 0;
+        DataPoint ecef = is_rbe
+            ? Coords::rbe_to_ecef(config.sensor_lla, config.sensor_ecef, sample.v[0], sample.v[1], sample.v[2])
+            : DataPoint{ sample.v[0], sample.v[1], sample.v[2] };
+
+        // Ham RBE sütunları yalnızca RBE örneği gelmiş veri setlerinde tutulur, diğer satırlar NaN olur
+        if (is_rbe || !ds.range_data.empty()) {
+            size_t rows = ds.time_data.size();
+            ds.range_data.resize(rows, nan);
+            ds.bearing_data.resize(rows, nan);
+            ds.elevation_data.resize(rows, nan);
+            ds.range_data.push_back(is_rbe ? sample.v[0] : nan);
+            ds.bearing_data.push_back(is_rbe ? sample.v[1] : nan);
+            ds.elevation_data.push_back(is_rbe ? sample.v[2] : nan);
+        }
+        ds.time_data.push_back(sample.time);
+        ds.x_data.push_back(ecef.x);
+        ds.y_data.push_back(ecef.y);
+        ds.z_data.push_back(ecef.z);
+        ds.points.push_back({ ecef.x - config.origin_ecef.x, ecef.y - config.origin_ecef.y, ecef.z - config.origin_ecef.z });
+        touched[idx] = true;
+    }
+    return rejected;
+}
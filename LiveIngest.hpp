@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+#include "DataStructures.hpp"
+
+// --- Canlı veri alımı ---
+// Çalışan bir füzyon sisteminden localhost UDP ile gelen ölçüm ve gerçek yörünge örnekleri. Bir datagram, art arda
+// dizilmiş sabit boyutlu (40 bayt, little-endian) kayıtlardan oluşur:
+//   uint32 stream   : hedef akış (LiveConfig::stream_datasets indeksi)
+//   uint32 flags    : LIVE_SAMPLE_RBE ise değerler sensöre göre menzil (m), yanca (deg), yükseliş (deg); değilse mutlak ECEF (m)
+//   double time     : örnek zamanı (s)
+//   double v[3]     : konum
+// Boyutu kayıt boyutunun katı olmayan datagramlar bozuk sayılır ve atılır.
+enum LiveSampleFlags : uint32_t { LIVE_SAMPLE_RBE = 1 };
+
+struct LiveSample {
+    uint32_t stream;
+    uint32_t flags;
+    double time;
+    double v[3];
+};
+
+constexpr size_t live_record_size = 40;
+
+// Canlı mod ayarları. Her akış başlangıçta (boş olarak) oluşturulmuş bir veri setine eklenir; veri seti adında
+// "Gercek" geçiyorsa akış gerçek yörünge olarak kullanılır. UDP alımı ve kayıt izleme birlikte kullanılabilir.
+struct LiveConfig {
+    uint16_t udp_port = 0;                  // 0: UDP alımı kapalı
+    std::string follow_path;                // Boş değilse izlenen kayıt dosyası (bkz. RecordingFollower)
+    uint32_t follow_stream = 0;             // Kayıt satırlarının eklendiği akış
+    DataPoint origin_lla = { 0, 0, 0 };     // Kayıttaki yerel konumların orijini
+    DataPoint origin_ecef = { 0, 0, 0 };    // Çizim koordinatlarının orijini
+    DataPoint sensor_lla = { 0, 0, 0 };     // RBE örneklerinin ölçüldüğü sensör
+    DataPoint sensor_ecef = { 0, 0, 0 };
+    std::vector<size_t> stream_datasets;    // Akış numarasından veri seti indeksine
+
+    bool enabled() const { return udp_port != 0 || !follow_path.empty(); }
+};
+
+// Tek üreticili, tek tüketicili kilitsiz halka kuyruk. Üretici yalnızca tail'i, tüketici yalnızca head'i yazar;
+// yuvaya yazılan değer release/acquire çifti ile karşı tarafa görünür olur. Kuyruk doluysa try_push false döner.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity ikinin kuvveti olmali");
+public:
+    bool try_push(T&& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity) return false;
+        slots[t & (Capacity - 1)] = std::move(value);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& out) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        out = std::move(slots[h & (Capacity - 1)]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::array<T, Capacity> slots;
+    alignas(64) std::atomic<size_t> head{ 0 };
+    alignas(64) std::atomic<size_t> tail{ 0 };
+};
+
+// Arka plan iş parçacığında UDP soketini dinler ve gelen örnekleri toplu hâlde kuyruğa verir. Bir toplu
+// yığın, soket kısa bir süre sessiz kalınca ya da batch_samples örneğe ulaşınca gönderilir; kuyruk doluysa
+// örnekler bir sonraki yığında birikir (max_pending_samples aşılırsa fazlası atılır ve sayılır).
+class LiveReceiver {
+public:
+    ~LiveReceiver() { stop(); }
+
+    // 127.0.0.1:port üzerinde dinlemeye başlar. Soket açılamazsa false döner, error nedeni içerir.
+    bool start(uint16_t port, std::string& error);
+    void stop();
+    bool running() const { return thread.joinable(); }
+
+    // Sıradaki örnek yığını (yalnızca ana iş parçacığından çağrılır)
+    bool pop(std::vector<LiveSample>& batch) { return queue.try_pop(batch); }
+
+    uint64_t datagrams_received() const { return datagrams; }
+    uint64_t samples_received() const { return samples; }
+    uint64_t samples_dropped() const { return dropped; }
+
+private:
+    static constexpr size_t batch_samples = 4096;
+    static constexpr size_t max_pending_samples = 1 << 22;
+    static constexpr int receive_timeout_ms = 5;
+
+    SpscQueue<std::vector<LiveSample>, 64> queue;
+    std::thread thread;
+    std::atomic<bool> stop_requested{ false };
+    std::atomic<uint64_t> datagrams{ 0 }, samples{ 0 }, dropped{ 0 };
+    intptr_t socket_handle = -1;
+
+    void receive_loop();
+};
+
+// Çalışan bir sistemin yazmaya devam ettiği senaryo kaydını (time,posX,velX,accX,posY,...,posZ,... CSV) izler.
+// Dosya baştan bir kez okunur, sonra yalnızca sona eklenen tamamlanmış satırlar ayrıştırılır; yarım kalan son
+// satır bir sonraki okumaya bırakılır. Linux'ta inotify ile değişiklik beklenir, diğer sistemlerde dosya boyutu
+// poll_interval_ms aralıklarla yoklanır. Dosya kısalırsa (yeniden yazıldıysa) okuma baştan başlar; eski zamanlı
+// satırlar appendLiveSamples tarafından zaten atılır. Konumlar origin_lla'ya göre yerel (Kuzey, Doğu, Yukarı)
+// kabul edilir ve mutlak ECEF örneklerine çevrilir.
+class RecordingFollower {
+public:
+    ~RecordingFollower() { stop(); }
+
+    // Dosya açılamazsa false döner, error nedeni içerir
+    bool start(const std::string& path, uint32_t stream, const DataPoint& origin_lla, std::string& error);
+    void stop();
+    bool running() const { return thread.joinable(); }
+
+    bool pop(std::vector<LiveSample>& batch) { return queue.try_pop(batch); }
+
+    uint64_t rows_parsed() const { return rows; }
+    uint64_t rows_malformed() const { return malformed; }
+
+private:
+    static constexpr size_t read_chunk_bytes = 4 * 1024 * 1024;
+    static constexpr int poll_interval_ms = 100;
+
+    SpscQueue<std::vector<LiveSample>, 64> queue;
+    std::thread thread;
+    std::atomic<bool> stop_requested{ false };
+    std::atomic<uint64_t> rows{ 0 }, malformed{ 0 };
+    std::string path;
+    uint32_t stream = 0;
+    DataPoint origin_lla = { 0, 0, 0 };
+    DataPoint origin_ecef = { 0, 0, 0 };
+
+    void follow_loop();
+    // text içindeki tamamlanmış satırları ayrıştırıp batch'e ekler, işlenen bayt sayısını döndürür
+    size_t parse_rows(const char* text, size_t size, bool at_file_start, std::vector<LiveSample>& batch);
+    // Kuyruk doluysa yer açılana (veya durdurulana) kadar bekler
+    void push_batch(std::vector<LiveSample>& batch);
+};
+
+// Örnekleri akışlarının veri setlerine yerinde ekler: zaman, mutlak ECEF, çizim noktası ve (RBE örneklerinde)
+// ham menzil/yanca/yükseliş sütunları. Veri setinin son zamanından eski örnekler ve bilinmeyen akışlar atılır.
+// Örnek eklenen veri setlerinin touched bayrağı true yapılır; türetilmiş sütunlar
+// sonraki erişimde yalnızca yeni satırlar için genişletilir.
+// Atılan örnek sayısını döndürür.
+size_t appendLiveSamples(std::vector<SearchableDataset>& datasets, const LiveConfig& config, const std::vector<LiveSample>& batch, std::vector<bool>& touched);
@@ -40,6 +40,19 @@ namespace Math
         return res;
     }
 
+    Mat4 orthographic(float left, float right, float bottom, float top, float z_near, float z_far)
+    {
+        Mat4 res;
+        res.m[0] = 2.0f / (right - left);
+        res.m[5] = 2.0f / (top - bottom);
+        res.m[10] = -2.0f / (z_far - z_near);
+        res.m[12] = -(right + left) / (right - left);
+        res.m[13] = -(top + bottom) / (top - bottom);
+        res.m[14] = -(z_far + z_near) / (z_far - z_near);
+        res.m[15] = 1.0f;
+        return res;
+    }
+
     Mat4 lookAt(const Vec3& eye, const Vec3& center, const Vec3& up)
     {
         Vec3 f = { center.x - eye.x, center.y - eye.y, center.z - eye.z };
@@ -85,10 +98,14 @@ namespace Math
     }
 
     bool project(const Vec3& obj, const Mat4& view, const Mat4& proj, int viewport_width, int viewport_height, Vec3& screen)
+    {
+        return project(obj, multiply(proj, view), viewport_width, viewport_height, screen);
+    }
+
+    bool project(const Vec3& obj, const Mat4& view_proj, int viewport_width, int viewport_height, Vec3& screen)
     {
         float in[4] = { obj.x, obj.y, obj.z, 1.0f };
         float out[4];
-        Mat4 view_proj = multiply(proj, view);
 
         out[0] = view_proj.m[0] * in[0] + view_proj.m[4] * in[1] + view_proj.m[8] * in[2] + view_proj.m[12] * in[3];
         out[1] = view_proj.m[1] * in[0] + view_proj.m[5] * in[1] + view_proj.m[9] * in[2] + view_proj.m[13] * in[3];
@@ -103,4 +120,55 @@ namespace Math
         screen.z = out[2];
         return true;
     }
+
+    // Ekrandaki bir pikselden geçen dünya uzayı ışınını hesaplar (perspektif veya ortografik projeksiyon).
+    void screen_ray(float screen_x, float screen_y, const Mat4& view, const Mat4& proj, int viewport_width, int viewport_height, Vec3& origin, Vec3& direction)
+    {
+        float ndc_x = 2.0f * screen_x / viewport_width - 1.0f;
+        float ndc_y = 1.0f - 2.0f * screen_y / viewport_height;
+        Vec3 dir_view = { ndc_x / proj.m[0], ndc_y / proj.m[5], -1.0f };
+
+        // View matrisinin dönme kısmının satırları, kameranın dünya uzayındaki eksenleridir.
+        Vec3 row0 = { view.m[0], view.m[4], view.m[8] };
+        Vec3 row1 = { view.m[1], view.m[5], view.m[9] };
+        Vec3 row2 = { view.m[2], view.m[6], view.m[10] };
+
+        // Ortografik izdüşümde tüm ışınlar paraleldir; piksel, ışının başlangıcını kamera düzleminde kaydırır
+        if (is_orthographic(proj))
+        {
+            float x_view = (ndc_x - proj.m[12]) / proj.m[0];
+            float y_view = (ndc_y - proj.m[13]) / proj.m[5];
+            Vec3 eye = camera_position(view);
+            origin = {
+                eye.x + row0.x * x_view + row1.x * y_view,
+                eye.y + row0.y * x_view + row1.y * y_view,
+                eye.z + row0.z * x_view + row1.z * y_view
+            };
+            direction = { -row2.x, -row2.y, -row2.z };
+            return;
+        }
+
+        direction = {
+            dir_view.x * row0.x + dir_view.y * row1.x + dir_view.z * row2.x,
+            dir_view.x * row0.y + dir_view.y * row1.y + dir_view.z * row2.y,
+            dir_view.x * row0.z + dir_view.y * row1.z + dir_view.z * row2.z
+        };
+        float len = sqrtf(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+        if (len > 1e-6)
+        {
+            direction.x /= len; direction.y /= len; direction.z /= len;
+        }
+
+        origin = camera_position(view);
+    }
+
+    // View matrisinden kameranın dünya uzayındaki konumunu çıkarır (-R^T * t).
+    Vec3 camera_position(const Mat4& view)
+    {
+        return {
+            -(view.m[12] * view.m[0] + view.m[13] * view.m[1] + view.m[14] * view.m[2]),
+            -(view.m[12] * view.m[4] + view.m[13] * view.m[5] + view.m[14] * view.m[6]),
+            -(view.m[12] * view.m[8] + view.m[13] * view.m[9] + view.m[14] * view.m[10])
+        };
+    }
 }
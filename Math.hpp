@@ -8,8 +8,13 @@ namespace Math
     Mat4 identity();
     Mat4 multiply(const Mat4& a, const Mat4& b);
     Mat4 perspective(float fov_rad, float aspect, float z_near, float z_far);
+    Mat4 orthographic(float left, float right, float bottom, float top, float z_near, float z_far);
+    inline bool is_orthographic(const Mat4& proj) { return proj.m[15] == 1.0f; }
     Mat4 lookAt(const Vec3& eye, const Vec3& center, const Vec3& up);
     Mat4 translate(const Mat4& m, const Vec3& v);
     Mat4 scale(const Mat4& m, const Vec3& v);
     bool project(const Vec3& obj, const Mat4& view, const Mat4& proj, int viewport_width, int viewport_height, Vec3& screen);
+    bool project(const Vec3& obj, const Mat4& view_proj, int viewport_width, int viewport_height, Vec3& screen);
+    Vec3 camera_position(const Mat4& view);
+    void screen_ray(float screen_x, float screen_y, const Mat4& view, const Mat4& proj, int viewport_width, int viewport_height, Vec3& origin, Vec3& direction);
 }
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+namespace Parallel
+{
+    // Donanımın desteklediği eşzamanlı iş parçacığı sayısı (en az 1)
+    inline size_t worker_count()
+    {
+        unsigned int n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : n;
+    }
+
+    // count elemanın, her biri en az min_chunk eleman içerecek şekilde kaç parçaya bölüneceği
+    inline size_t chunk_count(size_t count, size_t min_chunk)
+    {
+        if (count == 0) return 0;
+        size_t by_size = (count + min_chunk - 1) / std::max<size_t>(min_chunk, 1);
+        return std::clamp<size_t>(by_size, 1, worker_count());
+    }
+
+    // [0, count) aralığını chunk_count(count, min_chunk) parçaya böler ve her parçayı
+    // fn(chunk_idx, begin, end) ile ayrı bir iş parçacığında işler. Tek parça çağıran iş parçacığında çalışır.
+    template <typename Fn>
+    void for_chunks(size_t count, size_t min_chunk, Fn&& fn)
+    {
+        size_t chunks = chunk_count(count, min_chunk);
+        if (chunks == 0) return;
+        if (chunks == 1)
+        {
+            fn(size_t(0), size_t(0), count);
+            return;
+        }
+        std::vector<std::thread> threads;
+        threads.reserve(chunks - 1);
+        for (size_t c = 1; c < chunks; ++c)
+        {
+            threads.emplace_back([&fn, c, chunks, count]() { fn(c, count * c / chunks, count * (c + 1) / chunks); });
+        }
+        fn(size_t(0), size_t(0), count / chunks);
+        for (auto& t : threads) t.join();
+    }
+}
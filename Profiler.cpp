@@ -0,0 +1,175 @@
+#include "Profiler.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+void Profiler::Section::statistics(float& avg, float& p50, float& p95, float& p99, float& max) const {
+    avg = p50 = p95 = p99 = max = 0.0f;
+    if (count == 0) return;
+    std::vector<float> sorted(history, history + count);
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0.0;
+    for (float v : sorted) sum += v;
+    auto percentile = [&](float p) { return sorted[std::min<size_t>(sorted.size() - 1, (size_t)(p * sorted.size()))]; };
+    avg = (float)(sum / sorted.size());
+    p50 = percentile(0.50f);
+    p95 = percentile(0.95f);
+    p99 = percentile(0.99f);
+    max = sorted.back();
+}
+
+void Profiler::Section::ordered(std::vector<float>& out) const {
+    out.resize(count);
+    int oldest = count < history_size ? 0 : head;
+    for (int i = 0; i < count; ++i) {
+        out[i] = history[(oldest + i) % history_size];
+    }
+}
+
+Profiler::~Profiler() {
+    for (auto& frame : gpu_frames) {
+        if (!frame.queries.empty()) glDeleteQueries((GLsizei)frame.queries.size(), frame.queries.data());
+    }
+}
+
+int Profiler::section_index(const char* name, bool gpu) {
+    for (size_t i = 0; i < section_list.size(); ++i) {
+        if (section_list[i].gpu == gpu && section_list[i].name == name) return (int)i;
+    }
+    section_list.push_back({});
+    section_list.back().name = name;
+    section_list.back().gpu = gpu;
+    frame_ms.push_back(-1.0);
+    return (int)section_list.size() - 1;
+}
+
+void Profiler::add_sample(int section, double ms) {
+    frame_ms[section] = std::max(frame_ms[section], 0.0) + ms;
+}
+
+void Profiler::begin_frame() {
+    if (!enabled) return;
+    frame_start = Clock::now();
+    frame_started = true;
+
+    // Bu karenin sorgu yuvası gpu_frame_latency kare önce kullanılmıştı; sonuçları artık hazır olmalı
+    gpu_frame = (gpu_frame + 1) % gpu_frame_latency;
+    GpuFrame& frame = gpu_frames[gpu_frame];
+    if (frame.pending) collect_gpu_frame(frame);
+    frame.used = 0;
+    frame.pending = true;
+    frame.captured = capture_frames_left > 0;
+}
+
+void Profiler::end_frame() {
+    if (!enabled || !frame_started) return;
+    if (gpu_open) gpu_end();
+    add_sample(section_index("Kare", false), std::chrono::duration<double, std::milli>(Clock::now() - frame_start).count());
+    frame_started = false;
+    cpu_stack.clear();
+    for (size_t i = 0; i < section_list.size(); ++i) {
+        if (frame_ms[i] < 0.0) continue;
+        Section& section = section_list[i];
+        section.history[section.head] = (float)frame_ms[i];
+        section.head = (section.head + 1) % history_size;
+        section.count = std::min(section.count + 1, history_size);
+        frame_ms[i] = -1.0;
+    }
+    if (capture_frames_left > 0) capture_frames_left--;
+}
+
+void Profiler::cpu_begin(const char* name) {
+    if (!enabled) return;
+    cpu_stack.push_back({ section_index(name, false), Clock::now() });
+}
+
+void Profiler::cpu_end() {
+    if (!enabled || cpu_stack.empty()) return;
+    CpuMark mark = cpu_stack.back();
+    cpu_stack.pop_back();
+    Clock::time_point now = Clock::now();
+    double ms = std::chrono::duration<double, std::milli>(now - mark.start).count();
+    add_sample(mark.section, ms);
+    if (capture_frames_left > 0) {
+        double ts = std::chrono::duration<double, std::micro>(mark.start - capture_cpu_base).count();
+        trace_events.push_back({ mark.section, 1, ts, ms * 1000.0 });
+    }
+}
+
+void Profiler::gpu_begin(const char* name) {
+    if (!enabled) return;
+    if (gpu_open) gpu_end();
+    GpuFrame& frame = gpu_frames[gpu_frame];
+    if (frame.queries.size() < 2 * (frame.used + 1)) {
+        size_t old_size = frame.queries.size();
+        frame.queries.resize(old_size + 2);
+        glGenQueries(2, frame.queries.data() + old_size);
+        frame.sections.resize(frame.queries.size() / 2);
+    }
+    frame.sections[frame.used] = section_index(name, true);
+    glQueryCounter(frame.queries[2 * frame.used], GL_TIMESTAMP);
+    gpu_open = true;
+}
+
+void Profiler::gpu_end() {
+    if (!enabled || !gpu_open) return;
+    GpuFrame& frame = gpu_frames[gpu_frame];
+    glQueryCounter(frame.queries[2 * frame.used + 1], GL_TIMESTAMP);
+    frame.used++;
+    gpu_open = false;
+}
+
+void Profiler::collect_gpu_frame(GpuFrame& frame) {
+    frame.pending = false;
+    GLint available = 1;
+    if (frame.used > 0) glGetQueryObjectiv(frame.queries[2 * frame.used - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    // Hazır değilse beklemek yerine bu karenin GPU örnekleri atılır
+    if (available) {
+        for (size_t k = 0; k < frame.used; ++k) {
+            GLuint64 begin = 0, end = 0;
+            glGetQueryObjectui64v(frame.queries[2 * k], GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(frame.queries[2 * k + 1], GL_QUERY_RESULT, &end);
+            double ms = end > begin ? (end - begin) / 1.0e6 : 0.0;
+            add_sample(frame.sections[k], ms);
+            if (frame.captured) {
+                double ts = ((GLint64)begin - capture_gpu_base) / 1000.0;
+                trace_events.push_back({ frame.sections[k], 2, ts, ms * 1000.0 });
+            }
+        }
+    }
+    if (frame.captured && capture_gpu_frames_left > 0) {
+        capture_gpu_frames_left--;
+        if (capture_gpu_frames_left == 0) write_capture();
+    }
+}
+
+void Profiler::start_capture(const std::string& path, int frame_count) {
+    if (capturing() || frame_count <= 0) return;
+    capture_path = path;
+    capture_frames_left = capture_gpu_frames_left = frame_count;
+    gpu_frames[gpu_frame].captured = true;  // İçinde bulunulan kare de sayılır
+    trace_events.clear();
+    // İki saat aynı ana hizalanır; GPU olayları CPU zaman çizelgesinde yaklaşık yerlerinde görünür
+    capture_cpu_base = Clock::now();
+    glGetInteger64v(GL_TIMESTAMP, &capture_gpu_base);
+}
+
+void Profiler::write_capture() {
+    std::ofstream out(capture_path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "Iz dosyasi yazilamadi: " << capture_path << std::endl;
+        trace_events.clear();
+        return;
+    }
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n";
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+    for (const auto& e : trace_events) {
+        out << ",\n{\"name\":\"" << section_list[e.section].name << "\",\"cat\":\"" << (e.tid == 1 ? "cpu" : "gpu")
+            << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.tid << ",\"ts\":" << e.ts_us << ",\"dur\":" << e.dur_us << "}";
+    }
+    out << "\n]}\n";
+    trace_events.clear();
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#define GLFW_INCLUDE_NONE
+#include <glad/glad.h>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdint>
+
+// Kare profilleyicisi: CPU bölümleri std::chrono ile, GPU bölümleri GL_TIMESTAMP sorgularıyla ölçülür.
+// GPU sonuçları gpu_frame_latency kare sonra, GPU'yu bekletmeden okunur (hazır değilse o karenin örneği atılır).
+// Her bölüm için yalnızca ölçüldüğü karelerin toplam süresi geçmişe yazılır.
+class Profiler {
+public:
+    static constexpr int history_size = 240;
+    static constexpr int gpu_frame_latency = 4;
+
+    struct Section {
+        std::string name;
+        bool gpu = false;
+        float history[history_size] = {};   // ms, halka
+        int head = 0, count = 0;
+
+        float last() const { return count > 0 ? history[(head + history_size - 1) % history_size] : 0.0f; }
+        // Geçmişteki örneklerin ortalaması ve yüzdelikleri (ms)
+        void statistics(float& avg, float& p50, float& p95, float& p99, float& max) const;
+        // PlotLines için en eskiden en yeniye sıralı kopya
+        void ordered(std::vector<float>& out) const;
+    };
+
+    bool enabled = true;
+
+    // Kare başında hazır GPU sonuçlarını toplar. "Kare" bölümü begin_frame ile end_frame arasını ölçer;
+    // olay beklemesinden sonra çağrılırsa boşta geçen süre kare süresine katılmaz.
+    void begin_frame();
+    void end_frame();     // Kare sonunda: bölümlerin kare toplamlarını geçmişe yazar
+
+    // CPU aralıkları iç içe olabilir (genellikle ProfileScope ile kullanılır)
+    void cpu_begin(const char* name);
+    void cpu_end();
+    // GPU aralıkları iç içe olamaz, ardışık olmalıdır (GpuProfileScope veya RenderQueue::submit)
+    void gpu_begin(const char* name);
+    void gpu_end();
+
+    const std::vector<Section>& sections() const { return section_list; }
+
+    // Sonraki frame_count karenin CPU ve GPU aralıklarını Chrome izleme biçiminde (chrome://tracing,
+    // Perfetto) path'e yazar. Dosya, son karenin GPU sonuçları da toplandıktan sonra kaydedilir.
+    void start_capture(const std::string& path, int frame_count);
+    bool capturing() const { return capture_frames_left > 0 || capture_gpu_frames_left > 0; }
+    const std::string& last_capture_path() const { return capture_path; }
+
+    ~Profiler();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct CpuMark {
+        int section;
+        Clock::time_point start;
+    };
+    struct GpuFrame {
+        std::vector<GLuint> queries;    // [2k]: başlangıç, [2k+1]: bitiş
+        std::vector<int> sections;      // k. aralığın bölümü
+        size_t used = 0;                // Kullanılan aralık sayısı
+        bool pending = false;
+        bool captured = false;          // Aralıkları izleme kaydına yazılacak
+    };
+    struct TraceEvent {
+        int section;
+        int tid;            // 1: CPU, 2: GPU
+        double ts_us, dur_us;
+    };
+
+    std::vector<Section> section_list;
+    std::vector<double> frame_ms;       // section_list ile aynı sırada bu karenin toplamı (<0: ölçülmedi)
+    std::vector<CpuMark> cpu_stack;
+    GpuFrame gpu_frames[gpu_frame_latency];
+    int gpu_frame = 0;
+    bool gpu_open = false;
+    Clock::time_point frame_start;
+    bool frame_started = false;
+
+    std::string capture_path;
+    int capture_frames_left = 0, capture_gpu_frames_left = 0;
+    Clock::time_point capture_cpu_base;
+    GLint64 capture_gpu_base = 0;
+    std::vector<TraceEvent> trace_events;
+
+    int section_index(const char* name, bool gpu);
+    void add_sample(int section, double ms);
+    void collect_gpu_frame(GpuFrame& frame);
+    void write_capture();
+};
+
+// Kapsam boyunca süren CPU ölçümü
+class ProfileScope {
+public:
+    ProfileScope(Profiler& profiler, const char* name) : profiler(profiler) { profiler.cpu_begin(name); }
+    ~ProfileScope() { profiler.cpu_end(); }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    Profiler& profiler;
+};
+
+// Kapsam boyunca gönderilen GL komutlarının GPU süresi
+class GpuProfileScope {
+public:
+    GpuProfileScope(Profiler& profiler, const char* name) : profiler(profiler) { profiler.gpu_begin(name); }
+    ~GpuProfileScope() { profiler.gpu_end(); }
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+private:
+    Profiler& profiler;
+};
@@ -0,0 +1,338 @@
+#include "Query.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <charconv>
+
+// --- SelectionBitmap ---
+void SelectionBitmap::reset(size_t row_count, bool value) {
+    size = row_count;
+    words.assign((row_count + 63) / 64, value ? ~uint64_t(0) : 0);
+    if (value && (row_count & 63)) words.back() = (uint64_t(1) << (row_count & 63)) - 1;
+}
+
+size_t SelectionBitmap::count() const {
+    size_t total = 0;
+    for (uint64_t w : words) total += std::popcount(w);
+    return total;
+}
+
+void SelectionBitmap::indices(std::vector<uint32_t>& out) const {
+    out.clear();
+    out.reserve(count());
+    for (size_t w = 0; w < words.size(); ++w) {
+        uint64_t bits = words[w];
+        while (bits) {
+            out.push_back((uint32_t)(w * 64 + std::countr_zero(bits)));
+            bits &= bits - 1;
+        }
+    }
+}
+
+
+// --- Ayrıştırıcı ---
+// Özyinelemeli iniş; düğümler Query::nodes dizisine eklenir, çocuklar indeksle gösterilir.
+class QueryParser {
+public:
+    QueryParser(const std::string& text, std::vector<Query::Node>& nodes) : text(text), nodes(nodes) {}
+
+    int parse(std::string& error) {
+        int root = parse_or();
+        skip_spaces();
+        if (root >= 0 && pos < text.size()) fail("beklenmeyen ifade");
+        if (!message.empty()) {
+            error = message + " (konum " + std::to_string(error_pos + 1) + ")";
+            return -1;
+        }
+        return root;
+    }
+
+private:
+    const std::string& text;
+    std::vector<Query::Node>& nodes;
+    size_t pos = 0;
+    std::string message;
+    size_t error_pos = 0;
+
+    int fail(const char* what) {
+        if (message.empty()) {
+            message = what;
+            error_pos = pos;
+        }
+        return -1;
+    }
+
+    void skip_spaces() {
+        while (pos < text.size() && std::isspace((unsigned char)text[pos])) pos++;
+    }
+
+    bool accept(const char* token) {
+        skip_spaces();
+        size_t len = std::char_traits<char>::length(token);
+        if (text.compare(pos, len, token) != 0) return false;
+        pos += len;
+        return true;
+    }
+
+    int add(Query::Node node) {
+        nodes.push_back(std::move(node));
+        return (int)nodes.size() - 1;
+    }
+
+    int add_logical(Query::Op op, int left, int right = -1) {
+        Query::Node node;
+        node.op = op;
+        node.left = left;
+        node.right = right;
+        return add(std::move(node));
+    }
+
+    int parse_or() {
+        int left = parse_and();
+        while (left >= 0 && accept("||")) {
+            int right = parse_and();
+            if (right < 0) return -1;
+            left = add_logical(Query::Op::Or, left, right);
+        }
+        return left;
+    }
+
+    int parse_and() {
+        int left = parse_unary();
+        while (left >= 0 && accept("&&")) {
+            int right = parse_unary();
+            if (right < 0) return -1;
+            left = add_logical(Query::Op::And, left, right);
+        }
+        return left;
+    }
+
+    int parse_unary() {
+        skip_spaces();
+        // "!=" bir karşılaştırmadır, burada yalnızca tek başına '!' değilleme olarak okunur
+        if (pos < text.size() && text[pos] == '!' && text.compare(pos, 2, "!=") != 0) {
+            pos++;
+            int operand = parse_unary();
+            if (operand < 0) return -1;
+            return add_logical(Query::Op::Not, operand);
+        }
+        if (accept("(")) {
+            int inner = parse_or();
+            if (inner < 0) return -1;
+            if (!accept(")")) return fail("')' bekleniyor");
+            return inner;
+        }
+        return parse_predicate();
+    }
+
+    bool parse_identifier(std::string& name) {
+        skip_spaces();
+        size_t start = pos;
+        while (pos < text.size() && (std::isalnum((unsigned char)text[pos]) || text[pos] == '_')) pos++;
+        name = text.substr(start, pos - start);
+        return !name.empty() && !std::isdigit((unsigned char)name[0]);
+    }
+
+    bool parse_number(double& value) {
+        skip_spaces();
+        const char* begin = text.data() + pos;
+        const char* end = text.data() + text.size();
+        if (begin < end && *begin == '+') begin++;
+        auto [ptr, ec] = std::from_chars(begin, end, value);
+        if (ec != std::errc()) return false;
+        pos = ptr - text.data();
+        return true;
+    }
+
+    int parse_predicate() {
+        Query::Node node;
+        if (!parse_identifier(node.column)) return fail("sutun adi bekleniyor");
+        if (node.column == "in") return fail("sutun adi bekleniyor");
+
+        skip_spaces();
+        size_t keyword_pos = pos;
+        std::string keyword;
+        if (parse_identifier(keyword) && keyword == "in") {
+            node.op = Query::Op::In;
+            if (!accept("[")) return fail("'[' bekleniyor");
+            if (!parse_number(node.a)) return fail("sayi bekleniyor");
+            if (!accept(",")) return fail("',' bekleniyor");
+            if (!parse_number(node.b)) return fail("sayi bekleniyor");
+            if (!accept("]")) return fail("']' bekleniyor");
+            return add(std::move(node));
+        }
+        pos = keyword_pos;
+
+        // İki karakterli işleçler tek karakterlilerden önce denenir
+        if (accept("<=")) node.op = Query::Op::LessEqual;
+        else if (accept(">=")) node.op = Query::Op::GreaterEqual;
+        else if (accept("==")) node.op = Query::Op::Equal;
+        else if (accept("!=")) node.op = Query::Op::NotEqual;
+        else if (accept("<")) node.op = Query::Op::Less;
+        else if (accept(">")) node.op = Query::Op::Greater;
+        else return fail("karsilastirma islemi bekleniyor");
+        if (!parse_number(node.a)) return fail("sayi bekleniyor");
+        return add(std::move(node));
+    }
+};
+
+bool Query::parse(const std::string& text, std::string& error) {
+    nodes.clear();
+    root = -1;
+    error.clear();
+    QueryParser parser(text, nodes);
+    root = parser.parse(error);
+    if (root < 0) {
+        nodes.clear();
+        if (error.empty()) error = "bos sorgu";
+        return false;
+    }
+    return true;
+}
+
+std::vector<std::string> Query::columns() const {
+    std::vector<std::string> names;
+    for (const auto& node : nodes) {
+        if (!node.column.empty() && std::find(names.begin(), names.end(), node.column) == names.end()) {
+            names.push_back(node.column);
+        }
+    }
+    return names;
+}
+
+
+// --- Değerlendirme ---
+namespace {
+    // [begin, end) kelimelerini doldurur: her kelime 64 satırın koşul sonucunu bitlerinde tutar
+    template <typename Pred>
+    void scan_words(const double* values, size_t value_count, uint64_t* words, size_t begin, size_t end, Pred pred) {
+        for (size_t w = begin; w < end; ++w) {
+            size_t row = w * 64;
+            if (row >= value_count) {
+                words[w] = 0;
+                continue;
+            }
+            const double* v = values + row;
+            uint64_t bits = 0;
+            if (value_count - row >= 64) {
+                for (unsigned k = 0; k < 64; ++k) bits |= (uint64_t)pred(v[k]) << k;
+            }
+            else {
+                unsigned tail = (unsigned)(value_count - row);
+                for (unsigned k = 0; k < tail; ++k) bits |= (uint64_t)pred(v[k]) << k;
+            }
+            words[w] = bits;
+        }
+    }
+}
+
+bool Query::decided_by_stats(const Node& node, const ColumnStats* stats, size_t column_size, bool& value) {
+    // İstatistikler sütunun şimdiki hâline ait değilse (büyüyen veri setleri) kullanılamaz
+    if (!stats || stats->count + stats->nan_count != column_size) return false;
+    if (stats->count == 0) {
+        value = false;
+        return true;
+    }
+    double mn = stats->min, mx = stats->max, a = node.a, b = node.b;
+    bool none = false, all = false;
+    switch (node.op) {
+    case Op::Less:         none = mn >= a; all = mx < a; break;
+    case Op::LessEqual:    none = mn > a;  all = mx <= a; break;
+    case Op::Greater:      none = mx <= a; all = mn > a; break;
+    case Op::GreaterEqual: none = mx < a;  all = mn >= a; break;
+    case Op::Equal:        none = a < mn || a > mx; all = mn == a && mx == a; break;
+    case Op::NotEqual:     none = mn == a && mx == a; all = a < mn || a > mx; break;
+    case Op::In:           none = a > b || mx < a || mn > b; all = mn >= a && mx <= b; break;
+    default: return false;
+    }
+    if (none) {
+        value = false;
+        return true;
+    }
+    // NaN satırlar koşulu sağlamadığından "hepsi" yalnızca NaN yoksa geçerlidir
+    if (all && stats->nan_count == 0) {
+        value = true;
+        return true;
+    }
+    return false;
+}
+
+void Query::scan(const Node& node, const std::vector<double>& column, SelectionBitmap& result) const {
+    // Sütun satır sayısından kısaysa eksik satırlar koşulu sağlamaz
+    size_t value_count = std::min(column.size(), result.size);
+    const double* values = column.data();
+    uint64_t* words = result.words.data();
+    const double a = node.a, b = node.b;
+    Parallel::for_chunks(result.words.size(), parallel_min_rows / 64, [&](size_t, size_t begin, size_t end)
+    {
+        switch (node.op) {
+        case Op::Less:         scan_words(values, value_count, words, begin, end, [a](double x) { return x < a; }); break;
+        case Op::LessEqual:    scan_words(values, value_count, words, begin, end, [a](double x) { return x <= a; }); break;
+        case Op::Greater:      scan_words(values, value_count, words, begin, end, [a](double x) { return x > a; }); break;
+        case Op::GreaterEqual: scan_words(values, value_count, words, begin, end, [a](double x) { return x >= a; }); break;
+        case Op::Equal:        scan_words(values, value_count, words, begin, end, [a](double x) { return x == a; }); break;
+        case Op::NotEqual:     scan_words(values, value_count, words, begin, end, [a](double x) { return (x < a) | (x > a); }); break;
+        case Op::In:           scan_words(values, value_count, words, begin, end, [a, b](double x) { return (x >= a) & (x <= b); }); break;
+        default: break;
+        }
+    });
+}
+
+bool Query::evaluate_node(int node_idx, const SearchableDataset& ds, SelectionBitmap& result, std::string& error) const {
+    const Node& node = nodes[node_idx];
+    size_t rows = ds.points.size();
+    switch (node.op) {
+    case Op::And:
+    case Op::Or: {
+        if (!evaluate_node(node.left, ds, result, error)) return false;
+        SelectionBitmap other;
+        if (!evaluate_node(node.right, ds, other, error)) return false;
+        uint64_t* dst = result.words.data();
+        const uint64_t* src = other.words.data();
+        size_t word_count = result.words.size();
+        bool is_and = node.op == Op::And;
+        Parallel::for_chunks(word_count, parallel_min_rows / 64, [&](size_t, size_t begin, size_t end)
+        {
+            if (is_and) for (size_t w = begin; w < end; ++w) dst[w] &= src[w];
+            else for (size_t w = begin; w < end; ++w) dst[w] |= src[w];
+        });
+        return true;
+    }
+    case Op::Not: {
+        if (!evaluate_node(node.left, ds, result, error)) return false;
+        for (auto& w : result.words) w = ~w;
+        if ((rows & 63) && !result.words.empty()) result.words.back() &= (uint64_t(1) << (rows & 63)) - 1;
+        return true;
+    }
+    default: {
+        const std::vector<double>* column = ds.find_column(node.column);
+        if (!column) {
+            error = "'" + node.column + "' sutunu " + ds.name + " veri setinde yok";
+            return false;
+        }
+        bool value = false;
+        if (decided_by_stats(node, ds.stats(node.column), column->size(), value) && (!value || column->size() >= rows)) {
+            result.reset(rows, value);
+            return true;
+        }
+        result.reset(rows, false);
+        scan(node, *column, result);
+        return true;
+    }
+    }
+}
+
+bool Query::evaluate(const SearchableDataset& ds, SelectionBitmap& result, std::string& error) const {
+    error.clear();
+    if (root < 0) {
+        result.reset(ds.points.size(), false);
+        error = "bos sorgu";
+        return false;
+    }
+    if (!evaluate_node(root, ds, result, error)) {
+        result.reset(ds.points.size(), false);
+        return false;
+    }
+    return true;
+}
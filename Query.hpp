@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "DataStructures.hpp"
+
+// Satır başına bir bit; 64 satır bir kelimede. Son kelimenin kullanılmayan bitleri her zaman sıfırdır.
+struct SelectionBitmap {
+    std::vector<uint64_t> words;
+    size_t size = 0;
+
+    void reset(size_t row_count, bool value);
+    bool test(size_t row) const { return (words[row >> 6] >> (row & 63)) & 1u; }
+    size_t count() const;
+    // Seçili satırların indeksleri, artan sırada
+    void indices(std::vector<uint32_t>& out) const;
+};
+
+// Veri seti sütunları üzerinde bileşik koşul sorgusu, örn. "range > 5000 && elevation < 3 && t in [10, 20]".
+// Dilbilgisi:
+//   ifade    := ve ('||' ve)*
+//   ve       := birli ('&&' birli)*
+//   birli    := '!' birli | '(' ifade ')' | sütun karşılaştırma sayı | sütun 'in' '[' sayı ',' sayı ']'
+//   karşılaştırma := '<' | '<=' | '>' | '>=' | '==' | '!='
+// Sütun adları SearchableDataset::find_column ile çözülür (t, x, y, z, range, bearing, elevation ve türetilmiş sütunlar).
+// Her koşul, sütunun tamamı üzerinde satır bloklarına bölünmüş paralel ve dallanmasız bir taramayla bir bitmap üretir;
+// düğümler bitmapleri kelime kelime birleştirir. Sütun istatistikleri koşulun sonucunu kesinleştiriyorsa tarama atlanır.
+// NaN değerler hiçbir karşılaştırmayı sağlamaz.
+class Query {
+public:
+    // Ayrıştırma hatasında false döner; error konumu ve nedeni içerir.
+    bool parse(const std::string& text, std::string& error);
+    bool empty() const { return nodes.empty(); }
+
+    // Veri setinin tüm satırları için değerlendirir. Sorgudaki bir sütun veri setinde yoksa false döner.
+    bool evaluate(const SearchableDataset& ds, SelectionBitmap& result, std::string& error) const;
+
+    // Sorguda geçen sütun adları (dışa aktarma vb. için), tekrar etmeden
+    std::vector<std::string> columns() const;
+
+private:
+    enum class Op : uint8_t { And, Or, Not, Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual, In };
+    struct Node {
+        Op op = Op::Less;
+        int left = -1, right = -1;  // Çocuk düğümler (Not: yalnızca left)
+        std::string column;         // Karşılaştırma ve In
+        double a = 0.0, b = 0.0;    // Sabit; In için [a, b]
+    };
+
+    // Bu satır sayısından küçük taramalar tek iş parçacığında yapılır
+    static constexpr size_t parallel_min_rows = 1 << 18;
+
+    std::vector<Node> nodes;
+    int root = -1;
+
+    bool evaluate_node(int node_idx, const SearchableDataset& ds, SelectionBitmap& result, std::string& error) const;
+    void scan(const Node& node, const std::vector<double>& column, SelectionBitmap& result) const;
+    // Sütun istatistiklerine göre sonuç tüm satırlar için aynıysa value'ya yazar ve true döner
+    static bool decided_by_stats(const Node& node, const ColumnStats* stats, size_t column_size, bool& value);
+
+    friend class QueryParser;
+};
@@ -1,6 +1,10 @@
 #include "Renderer.hpp"
 #include <numbers>
 #include <iostream>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
 #include "imgui.h" // Renk dönüşümü için
 
 // Shader kaynak kodları
@@ -9,24 +13,224 @@ const char* color_vertex_shader = R"(
     layout(location = 0) in vec3 aPos;
     layout(location = 1) in vec3 aColor;
     out vec3 FragColor;
+    flat out uint PickIndex;
     uniform mat4 model;
-    uniform mat4 view;
-    uniform mat4 projection;
+    layout(std140) uniform Frame {
+        mat4 view;
+        mat4 projection;
+        vec2 time_window;                 // [t_start, t_end] (s)
+        int fade_time_window;             // Pencerenin eski ucuna doğru soluklaştır
+    };
     void main() {
         gl_Position = projection * view * model * vec4(aPos, 1.0);
         FragColor = aColor;
+        PickIndex = uint(gl_VertexID);
     }
 )";
 
 const char* color_fragment_shader = R"(
     #version 330 core
     in vec3 FragColor;
-    out vec4 OutColor;
+    flat in uint PickIndex;
+    layout(location = 0) out vec4 OutColor;
+    layout(location = 1) out uvec2 OutId;
+    uniform uint object_id; // 0: seçilemez nesne, aksi halde veri seti indeksi + 1
     void main() {
         OutColor = vec4(FragColor, 1.0);
+        OutId = uvec2(object_id, PickIndex);
+    }
+)";
+
+// Veri setleri sıkıştırılmış köşelerle çizilir: konum, parça tablosundaki merkez + int16 * ölçek,
+// renk ise veri seti başına uniform.
+const char* dataset_vertex_shader = R"(
+    #version 330 core
+    layout(location = 0) in vec3 aPos;    // int16, parça merkezine göre
+    layout(location = 1) in uint aChunk;
+    layout(location = 2) in float aColorValue; // Nokta bulutları: renk özniteliği
+    layout(location = 3) in float aSizeValue;  // Nokta bulutları: boyut özniteliği
+    layout(location = 4) in float aTime;
+    flat out uint PickIndex;
+    out vec3 VertexColor;
+    out float Visibility;                 // < 0: zaman penceresi dışında
+    uniform samplerBuffer chunk_table;    // xyz: parça merkezi, w: ölçek
+    uniform sampler1D colormap;
+    layout(std140) uniform Frame {
+        mat4 view;
+        mat4 projection;
+        vec2 time_window;                 // [t_start, t_end] (s)
+        int fade_time_window;             // Pencerenin eski ucuna doğru soluklaştır
+    };
+    uniform uint pick_index_flag;         // Kaba LOD köşeleri için en üst bit
+    uniform vec3 object_color;
+    uniform int use_color_attribute;
+    uniform vec2 color_range;
+    uniform int use_size_attribute;
+    uniform vec2 size_range;
+    uniform vec2 point_size_px;           // x: sabit/en küçük boyut, y: en büyük boyut
+    uniform int use_time_window;
+    float normalized(float v, vec2 range) {
+        return clamp((v - range.x) / max(range.y - range.x, 1e-12), 0.0, 1.0);
+    }
+    void main() {
+        vec4 chunk = texelFetch(chunk_table, int(aChunk));
+        gl_Position = projection * view * vec4(chunk.xyz + aPos * chunk.w, 1.0);
+        PickIndex = uint(gl_VertexID) | pick_index_flag;
+        VertexColor = object_color;
+        if (use_color_attribute != 0) {
+            VertexColor = isnan(aColorValue) ? vec3(0.5) : texture(colormap, normalized(aColorValue, color_range)).rgb;
+        }
+        gl_PointSize = point_size_px.x;
+        if (use_size_attribute != 0 && !isnan(aSizeValue)) {
+            gl_PointSize = mix(point_size_px.x, point_size_px.y, normalized(aSizeValue, size_range));
+        }
+        Visibility = 1.0;
+        if (use_time_window != 0) {
+            if (aTime < time_window.x || aTime > time_window.y) Visibility = -1.0;
+            else if (fade_time_window != 0) Visibility = mix(0.15, 1.0, normalized(aTime, time_window));
+        }
     }
 )";
 
+const char* dataset_fragment_shader = R"(
+    #version 330 core
+    flat in uint PickIndex;
+    in vec3 VertexColor;
+    in float Visibility;
+    layout(location = 0) out vec4 OutColor;
+    layout(location = 1) out uvec2 OutId;
+    uniform uint object_id;
+    uniform int round_points;
+    void main() {
+        if (round_points != 0) {
+            vec2 c = gl_PointCoord * 2.0 - 1.0;
+            if (dot(c, c) > 1.0) discard;
+        }
+        if (Visibility < 0.0) discard;
+        OutColor = vec4(VertexColor * Visibility, 1.0);
+        OutId = uvec2(object_id, PickIndex);
+    }
+)";
+
+// Hedef modelleri: tüm gerçek veri setlerinin hedefleri tek örneklemeli çizimle, model matrisi örnek başına öznitelik
+const char* target_vertex_shader = R"(
+    #version 330 core
+    layout(location = 0) in vec3 aPos;
+    layout(location = 1) in vec3 aColor;
+    layout(location = 2) in mat4 aModel;      // 2..5. konumlar, örnek başına
+    out vec3 FragColor;
+    flat out uint PickIndex;
+    layout(std140) uniform Frame {
+        mat4 view;
+        mat4 projection;
+        vec2 time_window;
+        int fade_time_window;
+    };
+    void main() {
+        gl_Position = projection * view * aModel * vec4(aPos, 1.0);
+        FragColor = aColor;
+        PickIndex = uint(gl_InstanceID);
+    }
+)";
+
+// Toplu artık alanı: her ölçüm için bir örnek (instance), iki köşeli çizgi. 0. köşe ölçüm konumunda,
+// 1. köşe artık vektörünün residual_scale ile büyütülmüş ucunda. Renk artık büyüklüğünden.
+const char* residual_vertex_shader = R"(
+    #version 330 core
+    layout(location = 0) in vec3 aStart;      // Ölçüm (GL koordinatları)
+    layout(location = 1) in vec3 aEnd;        // Eşleşen gerçek konum
+    layout(location = 2) in float aMagnitude; // |ölçüm - gerçek| (m)
+    layout(location = 3) in float aTime;
+    out vec3 VertexColor;
+    out float Visibility;
+    uniform sampler1D colormap;
+    layout(std140) uniform Frame {
+        mat4 view;
+        mat4 projection;
+        vec2 time_window;
+        int fade_time_window;
+    };
+    uniform vec2 color_range;
+    uniform int use_time_window;
+    uniform float residual_scale;
+    float normalized(float v, vec2 range) {
+        return clamp((v - range.x) / max(range.y - range.x, 1e-12), 0.0, 1.0);
+    }
+    void main() {
+        vec3 p = gl_VertexID == 0 ? aStart : aStart + (aEnd - aStart) * residual_scale;
+        gl_Position = projection * view * vec4(p, 1.0);
+        VertexColor = texture(colormap, normalized(aMagnitude, color_range)).rgb;
+        Visibility = 1.0;
+        if (use_time_window != 0) {
+            if (aTime < time_window.x || aTime > time_window.y) Visibility = -1.0;
+            else if (fade_time_window != 0) Visibility = mix(0.15, 1.0, normalized(aTime, time_window));
+        }
+    }
+)";
+
+const char* residual_fragment_shader = R"(
+    #version 330 core
+    in vec3 VertexColor;
+    in float Visibility;
+    layout(location = 0) out vec4 OutColor;
+    layout(location = 1) out uvec2 OutId;
+    void main() {
+        if (Visibility < 0.0) discard;
+        OutColor = vec4(VertexColor * Visibility, 1.0);
+        OutId = uvec2(0u); // Artık çizgileri seçilemez
+    }
+)";
+
+// Yoğunluk haritası: nokta bulutları dataset_vertex_shader ile 1 piksellik noktalar olarak tek kanallı
+// kayan noktalı bir dokuya toplamalı karıştırmayla (GL_ONE, GL_ONE) sayılır.
+const char* density_fragment_shader = R"(
+    #version 330 core
+    in float Visibility;
+    layout(location = 0) out float OutDensity;
+    void main() {
+        if (Visibility < 0.0) discard;
+        OutDensity = 1.0;
+    }
+)";
+
+// Yoğunluk dokusunu tam ekran bir üçgenle sahnenin arkasına çizer. Sayım log ile sıkıştırılır; referans
+// değer dokunun en üst mip seviyesindeki (tüm piksellerin) ortalamasından density_gain katıdır.
+const char* density_composite_vertex_shader = R"(
+    #version 330 core
+    void main() {
+        vec2 p = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+        gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);
+    }
+)";
+
+const char* density_composite_fragment_shader = R"(
+    #version 330 core
+    layout(location = 0) out vec4 OutColor;
+    layout(location = 1) out uvec2 OutId;
+    uniform sampler2D density;
+    uniform sampler1D colormap;
+    uniform float density_gain;
+    uniform int density_top_level;
+    void main() {
+        float d = texelFetch(density, ivec2(gl_FragCoord.xy), 0).r;
+        if (d <= 0.0) discard;
+        float mean = textureLod(density, vec2(0.5), float(density_top_level)).r;
+        float reference = max(1.0, density_gain * mean);
+        float t = clamp(log(1.0 + d) / log(1.0 + reference), 0.0, 1.0);
+        OutColor = vec4(texture(colormap, t).rgb, mix(0.35, 1.0, t));
+        OutId = uvec2(0u); // Yoğunluk haritası seçilemez
+    }
+)";
+
+// Frame uniform bloğunun std140 yerleşimi
+struct FrameBlock {
+    float view[16];
+    float projection[16];
+    float time_window[2];
+    GLint fade_time_window;
+    GLint padding;
+};
+
 // Shader derleme ve program oluşturma yardımcı fonksiyonları
 GLuint compile_shader(const char* source, GLenum type) {
     GLuint shader = glCreateShader(type);
@@ -72,7 +276,7 @@ void RenderObject::cleanup() {
 
 
 // --- Renderer Metotları ---
-Renderer::Renderer() : color_shader(0) {}
+Renderer::Renderer() : color_shader(0), dataset_shader(0), residual_shader(0), target_shader(0), density_shader(0), density_composite_shader(0) {}
 
 Renderer::~Renderer() {
     grid.cleanup();
@@ -81,23 +285,117 @@ Renderer::~Renderer() {
     target_obj.cleanup();
     selection_sphere.cleanup();
     error_vector_obj.cleanup();
-    for (auto& obj : dataset_render_objects) {
-        obj.cleanup();
+    error_vector_ring.destroy();
+    target_instance_ring.destroy();
+    upload_ring.destroy();
+    for (auto& gpu : dataset_gpu) {
+        gpu.base.cleanup();
+        gpu.coarse.cleanup();
+        gpu.base_buffer.destroy();
+        gpu.coarse_buffer.destroy();
+        gpu.chunk_buffer.destroy();
+        gpu.time_buffer.destroy();
+        gpu.coarse_time_buffer.destroy();
+        gpu.residuals.cleanup();
+        gpu.residual_buffer.destroy();
+        if (gpu.highlight_ebo) glDeleteBuffers(1, &gpu.highlight_ebo);
+        if (gpu.chunk_texture) glDeleteTextures(1, &gpu.chunk_texture);
+        for (auto& attribute : gpu.attributes) {
+            attribute.buffer.destroy();
+        }
     }
     if (color_shader) glDeleteProgram(color_shader);
-    if (fbo) glDeleteFramebuffers(1, &fbo);
-    if (fbo_texture) glDeleteTextures(1, &fbo_texture);
-    if (rbo_depth) glDeleteRenderbuffers(1, &rbo_depth);
+    if (colormap_texture) glDeleteTextures(1, &colormap_texture);
+    if (frame_ubo) glDeleteBuffers(1, &frame_ubo);
+    if (dataset_shader) glDeleteProgram(dataset_shader);
+    if (residual_shader) glDeleteProgram(residual_shader);
+    if (target_shader) glDeleteProgram(target_shader);
+    if (density_shader) glDeleteProgram(density_shader);
+    if (density_composite_shader) glDeleteProgram(density_composite_shader);
+    if (density_vao) glDeleteVertexArrays(1, &density_vao);
+    destroy_density_target();
+    for (auto& readback : pick_ring) {
+        if (readback.fence) glDeleteSync(readback.fence);
+        if (readback.pbo) glDeleteBuffers(1, &readback.pbo);
+    }
+    destroy_fbo();
 }
 
-void Renderer::initialize(const std::vector<SearchableDataset>& datasets, float grid_size) {
+void Renderer::initialize(size_t dataset_count, float grid_size) {
     setup_shaders();
-    create_scene_objects(datasets, grid_size);
-    create_fbo(1920, 1080);
+    create_colormap();
+    create_scene_objects(grid_size);
+    dataset_gpu.resize(dataset_count);
+    glGetIntegerv(GL_MAX_SAMPLES, &max_fbo_samples);
+    GLint max_integer_samples = 1;
+    glGetIntegerv(GL_MAX_INTEGER_SAMPLES, &max_integer_samples);
+    max_fbo_samples = std::max(1, std::min(max_fbo_samples, max_integer_samples));
+    // Gerçek boyut ilk karede görüntü alanına göre resize_fbo ile belirlenir
+    create_fbo(16, 16, 1);
 }
 
 void Renderer::setup_shaders() {
     color_shader = create_shader_program(color_vertex_shader, color_fragment_shader);
+    dataset_shader = create_shader_program(dataset_vertex_shader, dataset_fragment_shader);
+    residual_shader = create_shader_program(residual_vertex_shader, residual_fragment_shader);
+    target_shader = create_shader_program(target_vertex_shader, color_fragment_shader);
+    density_shader = create_shader_program(dataset_vertex_shader, density_fragment_shader);
+    density_composite_shader = create_shader_program(density_composite_vertex_shader, density_composite_fragment_shader);
+
+    // Uniform konumları bir kez çözülür; kamera ve zaman penceresi kare başına tek bir uniform tamponundan okunur
+    render_queue.register_program(color_shader);
+    render_queue.register_program(dataset_shader);
+    render_queue.register_program(residual_shader);
+    render_queue.register_program(target_shader);
+    render_queue.register_program(density_shader);
+    glGenBuffers(1, &frame_ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, frame_ubo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameBlock), NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // Doku birimleri sabit
+    glUseProgram(dataset_shader);
+    glUniform1i(glGetUniformLocation(dataset_shader, "chunk_table"), 0);
+    glUniform1i(glGetUniformLocation(dataset_shader, "colormap"), 1);
+    glUseProgram(residual_shader);
+    glUniform1i(glGetUniformLocation(residual_shader, "colormap"), 1);
+    glUseProgram(density_shader);
+    glUniform1i(glGetUniformLocation(density_shader, "chunk_table"), 0);
+    glUseProgram(density_composite_shader);
+    glUniform1i(glGetUniformLocation(density_composite_shader, "colormap"), 1);
+    glUniform1i(glGetUniformLocation(density_composite_shader, "density"), 2);
+    density_gain_location = glGetUniformLocation(density_composite_shader, "density_gain");
+    density_top_level_location = glGetUniformLocation(density_composite_shader, "density_top_level");
+    glUseProgram(0);
+    // Tam ekran üçgen köşeleri gl_VertexID'den üretilir; çekirdek profil yine de bir VAO ister
+    glGenVertexArrays(1, &density_vao);
+}
+
+void Renderer::create_colormap() {
+    // Viridis renk haritasının kontrol noktaları arasında doğrusal enterpolasyonla 256 texel
+    static const float stops[9][3] = {
+        { 0.267f, 0.005f, 0.329f }, { 0.283f, 0.141f, 0.458f }, { 0.254f, 0.265f, 0.530f },
+        { 0.207f, 0.372f, 0.553f }, { 0.164f, 0.471f, 0.558f }, { 0.128f, 0.567f, 0.551f },
+        { 0.208f, 0.718f, 0.473f }, { 0.478f, 0.821f, 0.318f }, { 0.993f, 0.906f, 0.144f },
+    };
+    std::vector<unsigned char> texels(256 * 3);
+    for (int i = 0; i < 256; ++i) {
+        float f = i / 255.0f * 8.0f;
+        int k = std::min((int)f, 7);
+        float t = f - k;
+        for (int c = 0; c < 3; ++c) {
+            texels[i * 3 + c] = (unsigned char)lrintf(255.0f * (stops[k][c] + (stops[k + 1][c] - stops[k][c]) * t));
+        }
+    }
+    glGenTextures(1, &colormap_texture);
+    glBindTexture(GL_TEXTURE_1D, colormap_texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage1D(GL_TEXTURE_1D, 0, GL_RGB8, 256, 0, GL_RGB, GL_UNSIGNED_BYTE, texels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_1D, 0);
 }
 
 void Renderer::setup_render_object(RenderObject& object, const std::vector<float>& vertices, GLenum draw_mode, GLenum usage) {
@@ -119,6 +417,36 @@ void Renderer::setup_render_object(RenderObject& object, const std::vector<float
     glBindVertexArray(0);
 }
 
+void Renderer::bind_vertex_attributes(RenderObject& object, GLuint buffer) {
+    if (object.vao == 0) glGenVertexArrays(1, &object.vao);
+    glBindVertexArray(object.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+}
+
+void Renderer::bind_quantized_attributes(RenderObject& object, GLuint buffer) {
+    if (object.vao == 0) glGenVertexArrays(1, &object.vao);
+    glBindVertexArray(object.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glVertexAttribPointer(0, 3, GL_SHORT, GL_FALSE, sizeof(QuantizedVertex), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribIPointer(1, 1, GL_UNSIGNED_SHORT, sizeof(QuantizedVertex), (void*)offsetof(QuantizedVertex, chunk));
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+}
+
+void Renderer::bind_float_attribute(RenderObject& object, GLuint location, GLuint buffer) {
+    glBindVertexArray(object.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glVertexAttribPointer(location, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)0);
+    glEnableVertexAttribArray(location);
+    glBindVertexArray(0);
+}
+
 void Renderer::setup_indexed_render_object(RenderObject& object, const std::vector<float>& vertices, const std::vector<unsigned int>& indices) {
     glGenVertexArrays(1, &object.vao);
     glGenBuffers(1, &object.vbo);
@@ -138,7 +466,7 @@ void Renderer::setup_indexed_render_object(RenderObject& object, const std::vect
 }
 
 
-void Renderer::create_scene_objects(const std::vector<SearchableDataset>& datasets, float grid_size) {
+void Renderer::create_scene_objects(float grid_size) {
     // Grid, Eksenler... (önceki gibi)
     std::vector<float> grid_vertices;
     float half_size = grid_size / 2.0f;
@@ -233,6 +561,8 @@ void Renderer::create_scene_objects(const std::vector<SearchableDataset>& datase
         1, 11, 10
     };
     setup_indexed_render_object(target_obj, target_vertices, target_indices);
+    // Örnek başına model matrisleri her karede halka tampondan akıtılır
+    target_instance_ring.create(GL_ARRAY_BUFFER, 256 * 16 * sizeof(float), 16 * sizeof(float));
 
     // Seçim Küresi
     std::vector<float> sphere_vertices;
@@ -259,105 +589,675 @@ void Renderer::create_scene_objects(const std::vector<SearchableDataset>& datase
     }
     setup_indexed_render_object(selection_sphere, sphere_vertices, sphere_indices);
 
-    // Hata Vektörü
-    setup_render_object(error_vector_obj, {}, GL_LINES, GL_DYNAMIC_DRAW);
-
-    // Veri Seti (Yörünge Çizgileri)
-    dataset_render_objects.resize(datasets.size());
-    for (size_t i = 0; i < datasets.size(); ++i) {
-        std::vector<float> vertices;
-        for (const auto& p : datasets[i].points) {
-            vertices.push_back((float)p.x);
-            vertices.push_back((float)p.z);
-            vertices.push_back((float)-p.y);
-            ImU32 color = (datasets[i].name.find("Gercek") != std::string::npos) ? IM_COL32(0, 255, 0, 100) : IM_COL32(255, 0, 0, 100);
-            vertices.push_back(((color >> 0) & 0xFF) / 255.f);
-            vertices.push_back(((color >> 8) & 0xFF) / 255.f);
-            vertices.push_back(((color >> 16) & 0xFF) / 255.f);
+    // Hata Vektörü (VAO halka tampona bir kez bağlanır, çizimde first ile bölge seçilir)
+    error_vector_ring.create(GL_ARRAY_BUFFER, 256 * 6 * sizeof(float), 6 * sizeof(float));
+    bind_vertex_attributes(error_vector_obj, error_vector_ring.id());
+    error_vector_obj.draw_mode = GL_LINES;
+}
+
+Renderer::DatasetGpu& Renderer::dataset_slot(size_t dataset_idx, const SearchableDataset& dataset) {
+    if (dataset_idx >= dataset_gpu.size()) dataset_gpu.resize(dataset_idx + 1);
+    DatasetGpu& gpu = dataset_gpu[dataset_idx];
+    if (gpu.base.vao == 0) {
+        ImU32 color = is_truth_dataset(dataset) ? IM_COL32(0, 255, 0, 100) : IM_COL32(255, 0, 0, 100);
+        gpu.color[0] = ((color >> 0) & 0xFF) / 255.f;
+        gpu.color[1] = ((color >> 8) & 0xFF) / 255.f;
+        gpu.color[2] = ((color >> 16) & 0xFF) / 255.f;
+        gpu.is_line_series = dataset.is_line_series;
+        gpu.base.draw_mode = gpu.coarse.draw_mode = dataset.is_line_series ? GL_LINE_STRIP : GL_POINTS;
+        glGenVertexArrays(1, &gpu.base.vao);
+        if (gpu.is_line_series) glGenVertexArrays(1, &gpu.coarse.vao);
+        glGenTextures(1, &gpu.chunk_texture);
+        // Veri setinden önce seçilmiş bir görünüm varsa öznitelikleri şimdi bağlanır
+        apply_point_style(gpu);
+    }
+    return gpu;
+}
+
+void Renderer::sync_dataset(size_t dataset_idx, const SearchableDataset& dataset) {
+    DatasetGpu& gpu = dataset_slot(dataset_idx, dataset);
+    // Bekleyen arka plan yüklemesi varsa önce o tamamlanır, yeni noktalar onun üzerine eklenir
+    finish_pending_upload(dataset_idx);
+    if (gpu.geometry.point_count() == dataset.points.size() && gpu.base_buffer.id() != 0) return;
+
+    PendingUpload upload;
+    upload.dataset_idx = dataset_idx;
+    gpu.geometry.update(dataset, upload.update);
+    begin_upload(upload);
+    while (upload_step(upload, std::numeric_limits<size_t>::max(), nullptr)) {}
+}
+
+void Renderer::queue_dataset(size_t dataset_idx, const SearchableDataset& dataset, DatasetGeometry&& geometry, GeometryUpdate&& update) {
+    DatasetGpu& gpu = dataset_slot(dataset_idx, dataset);
+    finish_pending_upload(dataset_idx);
+    gpu.geometry = std::move(geometry);
+
+    PendingUpload upload;
+    upload.dataset_idx = dataset_idx;
+    upload.update = std::move(update);
+    begin_upload(upload);
+    pending_uploads.push_back(std::move(upload));
+}
+
+bool Renderer::upload_pending(size_t budget_bytes) {
+    if (pending_uploads.empty()) return false;
+    if (upload_ring.id() == 0) upload_ring.create(GL_COPY_READ_BUFFER, budget_bytes, 16);
+
+    // Bu karenin dilimleri tek bir hazırlık bölgesine toplanır, sonra GPU üzerinde hedef tamponlara kopyalanır
+    staging_bytes.clear();
+    staged_copies.clear();
+    size_t remaining = budget_bytes;
+    for (auto& upload : pending_uploads) {
+        while (remaining > 0) {
+            size_t before = staging_bytes.size();
+            bool more = upload_step(upload, remaining, &staging_bytes);
+            remaining -= staging_bytes.size() - before;
+            if (!more) break;
+        }
+        if (remaining == 0) break;
+    }
+    if (!staging_bytes.empty()) {
+        size_t base_offset = upload_ring.write(staging_bytes.data(), staging_bytes.size());
+        for (const auto& copy : staged_copies) {
+            stream_buffer(dataset_gpu[copy.dataset_idx], copy.stream).append_copy(upload_ring.id(), base_offset + copy.offset, copy.bytes);
+        }
+        upload_ring.fence();
+    }
+    for (auto& upload : pending_uploads) {
+        refresh_dataset_bindings(dataset_gpu[upload.dataset_idx]);
+    }
+    std::erase_if(pending_uploads, [](const PendingUpload& u) { return u.stream == upload_stream_count; });
+    return true;
+}
+
+float Renderer::upload_progress(size_t dataset_idx) const {
+    for (const auto& upload : pending_uploads) {
+        if (upload.dataset_idx == dataset_idx) {
+            size_t total = upload.update.bytes();
+            return total == 0 ? 1.0f : (float)upload.done_bytes / (float)total;
         }
-        if (vertices.empty()) continue;
-        setup_render_object(dataset_render_objects[i], vertices, datasets[i].is_line_series ? GL_LINE_STRIP : GL_POINTS);
     }
+    return dataset_idx < dataset_gpu.size() && dataset_gpu[dataset_idx].base_buffer.id() != 0 ? 1.0f : 0.0f;
+}
+
+GrowableBuffer& Renderer::stream_buffer(DatasetGpu& gpu, int stream) {
+    switch (stream) {
+    case UPLOAD_CHUNKS: return gpu.chunk_buffer;
+    case UPLOAD_COARSE_TIMES: return gpu.coarse_time_buffer;
+    case UPLOAD_COARSE_VERTICES: return gpu.coarse_buffer;
+    case UPLOAD_TIMES: return gpu.time_buffer;
+    default: return gpu.base_buffer;
+    }
+}
+
+void Renderer::stream_data(const GeometryUpdate& update, int stream, const void*& data, size_t& bytes, size_t& element, size_t& first) {
+    switch (stream) {
+    case UPLOAD_CHUNKS: data = update.chunks.data(); bytes = update.chunks.size() * sizeof(QuantChunk); element = sizeof(QuantChunk); first = update.first_chunk; break;
+    case UPLOAD_COARSE_TIMES: data = update.coarse_times.data(); bytes = update.coarse_times.size() * sizeof(float); element = sizeof(float); first = update.first_coarse; break;
+    case UPLOAD_COARSE_VERTICES: data = update.coarse_vertices.data(); bytes = update.coarse_vertices.size() * sizeof(QuantizedVertex); element = sizeof(QuantizedVertex); first = update.first_coarse; break;
+    case UPLOAD_TIMES: data = update.times.data(); bytes = update.times.size() * sizeof(float); element = sizeof(float); first = update.first_time; break;
+    default: data = update.base_vertices.data(); bytes = update.base_vertices.size() * sizeof(QuantizedVertex); element = sizeof(QuantizedVertex); first = update.first_point; break;
+    }
+}
+
+void Renderer::begin_upload(PendingUpload& upload) {
+    // Güncellenen aralıktan sonrası atılır; eski içerik yeni dilimler geldikçe üzerine yazılır
+    DatasetGpu& gpu = dataset_gpu[upload.dataset_idx];
+    for (int stream = 0; stream < upload_stream_count; ++stream) {
+        const void* data; size_t bytes, element, first;
+        stream_data(upload.update, stream, data, bytes, element, first);
+        GrowableBuffer& buffer = stream_buffer(gpu, stream);
+        buffer.truncate(first * element);
+        // İlk yükleme tam boyutta ve statik; veri seti büyürse tampon dinamik olarak yeniden ayrılır
+        if (buffer.id() == 0 && bytes > 0) buffer.reserve(first * element + bytes);
+    }
+    update_dataset_counts(gpu);
+    refresh_dataset_bindings(gpu);
+}
+
+bool Renderer::upload_step(PendingUpload& upload, size_t budget_bytes, std::vector<uint8_t>* staging) {
+    if (upload.stream == upload_stream_count) return false;
+    DatasetGpu& gpu = dataset_gpu[upload.dataset_idx];
+    const void* data; size_t bytes, element, first;
+    stream_data(upload.update, upload.stream, data, bytes, element, first);
+
+    // Dilimler eleman sınırında kesilir ki çizilebilen köşe sayısı her zaman tam olsun
+    size_t slice = std::min(bytes - upload.stream_offset, budget_bytes / element * element);
+    if (slice == 0 && upload.stream_offset < bytes) return false;
+    const uint8_t* src = (const uint8_t*)data + upload.stream_offset;
+    if (slice > 0 && staging) {
+        staged_copies.push_back({ upload.dataset_idx, upload.stream, staging->size(), slice });
+        staging->insert(staging->end(), src, src + slice);
+    }
+    else if (slice > 0) {
+        stream_buffer(gpu, upload.stream).append(src, slice);
+        refresh_dataset_bindings(gpu);
+    }
+    upload.stream_offset += slice;
+    upload.done_bytes += slice;
+    if (upload.stream_offset == bytes) {
+        upload.stream++;
+        upload.stream_offset = 0;
+    }
+    if (!staging) update_dataset_counts(gpu);
+    else gpu.pending_counts = true;
+    return upload.stream < upload_stream_count;
+}
+
+void Renderer::finish_pending_upload(size_t dataset_idx) {
+    for (auto it = pending_uploads.begin(); it != pending_uploads.end(); ++it) {
+        if (it->dataset_idx != dataset_idx) continue;
+        while (upload_step(*it, std::numeric_limits<size_t>::max(), nullptr)) {}
+        pending_uploads.erase(it);
+        return;
+    }
+}
+
+void Renderer::update_dataset_counts(DatasetGpu& gpu) {
+    // Yükleme sürerken yalnızca tamponlara tamamen ulaşmış köşeler çizilir
+    gpu.base.vertex_count = (GLsizei)(gpu.base_buffer.size() / sizeof(QuantizedVertex));
+    gpu.coarse.vertex_count = (GLsizei)(gpu.coarse_buffer.size() / sizeof(QuantizedVertex));
+    gpu.time_count = (GLsizei)(gpu.time_buffer.size() / sizeof(float));
+    gpu.pending_counts = false;
+}
+
+void Renderer::refresh_dataset_bindings(DatasetGpu& gpu) {
+    // Tampon büyürken yeniden oluşturulduysa (adı değiştiyse) VAO'lar ve parça dokusu yeni tampona bağlanır
+    if (gpu.pending_counts) update_dataset_counts(gpu);
+    if (gpu.base_buffer.id() != gpu.bound_base) {
+        bind_quantized_attributes(gpu.base, gpu.base_buffer.id());
+        gpu.bound_base = gpu.base_buffer.id();
+    }
+    if (gpu.time_buffer.id() != gpu.bound_time) {
+        bind_float_attribute(gpu.base, 4, gpu.time_buffer.id());
+        gpu.bound_time = gpu.time_buffer.id();
+    }
+    if (gpu.is_line_series && gpu.coarse_buffer.id() != gpu.bound_coarse) {
+        bind_quantized_attributes(gpu.coarse, gpu.coarse_buffer.id());
+        gpu.bound_coarse = gpu.coarse_buffer.id();
+    }
+    if (gpu.is_line_series && gpu.coarse_time_buffer.id() != gpu.bound_coarse_time) {
+        bind_float_attribute(gpu.coarse, 4, gpu.coarse_time_buffer.id());
+        gpu.bound_coarse_time = gpu.coarse_time_buffer.id();
+    }
+    if (gpu.chunk_buffer.id() != gpu.bound_chunks) {
+        glBindTexture(GL_TEXTURE_BUFFER, gpu.chunk_texture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, gpu.chunk_buffer.id());
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        gpu.bound_chunks = gpu.chunk_buffer.id();
+    }
+}
+
+void Renderer::upload_point_attribute(size_t dataset_idx, const std::string& name, const std::vector<float>& values, float vmin, float vmax,
+                                      size_t first_changed) {
+    if (dataset_idx >= dataset_gpu.size()) return;
+    DatasetGpu& gpu = dataset_gpu[dataset_idx];
+    auto it = std::find_if(gpu.attributes.begin(), gpu.attributes.end(), [&](const PointAttribute& a) { return a.name == name; });
+    if (it == gpu.attributes.end()) {
+        gpu.attributes.push_back({ name, {} });
+        it = gpu.attributes.end() - 1;
+        it->buffer.reserve(std::max<size_t>(values.size(), 1) * sizeof(float));
+    }
+    it->min = vmin;
+    it->max = vmax;
+    // Daha önce yüklenmiş kısım tekrar gönderilmez; veri seti büyüdükçe yalnızca yeni değerler eklenir.
+    // Değişen satırlar varsa tampon o satıra kadar kısaltılır ve kalan değerler üzerine yazılır.
+    size_t uploaded = it->buffer.size() / sizeof(float);
+    if (first_changed < uploaded) {
+        it->buffer.truncate(first_changed * sizeof(float));
+        uploaded = first_changed;
+    }
+    if (values.size() <= uploaded) return;
+    if (it->buffer.append(values.data() + uploaded, (values.size() - uploaded) * sizeof(float))) {
+        apply_point_style(gpu);
+    }
+}
+
+bool Renderer::point_attribute_range(size_t dataset_idx, const std::string& name, float& vmin, float& vmax) const {
+    if (dataset_idx >= dataset_gpu.size()) return false;
+    for (const auto& attribute : dataset_gpu[dataset_idx].attributes) {
+        if (attribute.name == name) {
+            vmin = attribute.min;
+            vmax = attribute.max;
+            return true;
+        }
+    }
+    return false;
+}
+
+void Renderer::set_point_style(size_t dataset_idx, const PointStyle& style) {
+    if (dataset_idx >= dataset_gpu.size()) return;
+    dataset_gpu[dataset_idx].style = style;
+    apply_point_style(dataset_gpu[dataset_idx]);
+}
+
+void Renderer::apply_point_style(DatasetGpu& gpu) {
+    // Yeniden renklendirme yalnızca VAO'daki öznitelik işaretçisini başka bir tampona yönlendirir
+    auto find = [&](const std::string& name) -> int {
+        if (name.empty()) return -1;
+        for (size_t a = 0; a < gpu.attributes.size(); ++a) {
+            if (gpu.attributes[a].name == name) return (int)a;
+        }
+        return -1;
+    };
+    gpu.color_attribute = find(gpu.style.color_attribute);
+    gpu.size_attribute = find(gpu.style.size_attribute);
+    if (gpu.base.vao == 0) return;
+
+    const int slots[2] = { gpu.color_attribute, gpu.size_attribute };
+    for (GLuint location = 2; location <= 3; ++location) {
+        int attribute = slots[location - 2];
+        if (attribute >= 0) {
+            bind_float_attribute(gpu.base, location, gpu.attributes[attribute].buffer.id());
+        }
+        else {
+            glBindVertexArray(gpu.base.vao);
+            glDisableVertexAttribArray(location);
+            glBindVertexArray(0);
+        }
+    }
+}
+
+void Renderer::upload_residual_field(size_t dataset_idx, const SearchableDataset& dataset, const AssociationTable& table,
+                                     size_t first_changed) {
+    if (dataset_idx >= dataset_gpu.size() || table.empty()) return;
+    DatasetGpu& gpu = dataset_gpu[dataset_idx];
+    // Örnekler yalnızca eşleşmiş ölçümlerden oluştuğundan satır-ofset karşılığı yoktur; yüklenmiş kısımda
+    // değişiklik varsa alan baştan kurulur
+    if (first_changed < gpu.residual_points) {
+        gpu.residual_buffer.truncate(0);
+        gpu.residual_points = 0;
+        gpu.residual_magnitudes.clear();
+        gpu.residual_p99 = 0.0f;
+        gpu.residuals.vertex_count = 0;
+    }
+    size_t point_count = std::min(dataset.points.size(), table.truth_points.size());
+    if (gpu.residual_points >= point_count) return;
+
+    // Yalnızca eşleşmesi olan ölçümler örnek olur; büyüyen veri setlerinde yalnızca yeni ölçümler eklenir
+    std::vector<ResidualInstance> instances;
+    instances.reserve(point_count - gpu.residual_points);
+    for (size_t i = gpu.residual_points; i < point_count; ++i) {
+        if (!table.is_valid(i)) continue;
+        const DataPoint& m = dataset.points[i];
+        const DataPoint& t = table.truth_points[i];
+        const DataPoint& r = table.residual_ecef[i];
+        ResidualInstance instance;
+        instance.start[0] = (float)m.x; instance.start[1] = (float)m.z; instance.start[2] = (float)-m.y;
+        instance.end[0] = (float)t.x; instance.end[1] = (float)t.z; instance.end[2] = (float)-t.y;
+        instance.magnitude = (float)std::sqrt(r.x * r.x + r.y * r.y + r.z * r.z);
+        instance.time = i < dataset.time_data.size() ? (float)dataset.time_data[i] : 0.0f;
+        instances.push_back(instance);
+    }
+    gpu.residual_points = point_count;
+    if (instances.empty()) return;
+
+    // Renk aralığının üst sınırı, tek tük aykırı eşleşmeler haritayı ezmesin diye 99. yüzdelik. Canlı modda alan
+    // küçük parçalarla büyüdüğünden yüzdelik yalnızca yeni parçadan değil, yüklenmiş tüm örneklerden alınır
+    for (const auto& instance : instances) gpu.residual_magnitudes.push_back(instance.magnitude);
+    auto p99 = gpu.residual_magnitudes.begin() + (gpu.residual_magnitudes.size() * 99) / 100;
+    std::nth_element(gpu.residual_magnitudes.begin(), p99, gpu.residual_magnitudes.end());
+    gpu.residual_p99 = *p99;
+
+    if (gpu.residual_buffer.id() == 0) gpu.residual_buffer.reserve(instances.size() * sizeof(ResidualInstance));
+    GLuint old_buffer = gpu.residual_buffer.id();
+    gpu.residual_buffer.append(instances.data(), instances.size() * sizeof(ResidualInstance));
+    if (gpu.residuals.vao == 0 || gpu.residual_buffer.id() != old_buffer) {
+        if (gpu.residuals.vao == 0) glGenVertexArrays(1, &gpu.residuals.vao);
+        glBindVertexArray(gpu.residuals.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, gpu.residual_buffer.id());
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ResidualInstance), (void*)offsetof(ResidualInstance, start));
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(ResidualInstance), (void*)offsetof(ResidualInstance, end));
+        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(ResidualInstance), (void*)offsetof(ResidualInstance, magnitude));
+        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(ResidualInstance), (void*)offsetof(ResidualInstance, time));
+        for (GLuint location = 0; location < 4; ++location) {
+            glEnableVertexAttribArray(location);
+            glVertexAttribDivisor(location, 1);
+        }
+        glBindVertexArray(0);
+    }
+    gpu.residuals.vertex_count = (GLsizei)(gpu.residual_buffer.size() / sizeof(ResidualInstance));
+    gpu.residuals.draw_mode = GL_LINES;
+}
+
+void Renderer::set_highlight(size_t dataset_idx, const std::vector<uint32_t>& indices) {
+    if (dataset_idx >= dataset_gpu.size() || dataset_gpu[dataset_idx].base.vao == 0) return;
+    DatasetGpu& gpu = dataset_gpu[dataset_idx];
+    gpu.highlight_indices = indices;
+    if (indices.empty()) return;
+    // İndeks tamponu VAO durumudur; base.vao'ya bir kez bağlanır, glDrawArrays çizimleri onu kullanmaz
+    if (gpu.highlight_ebo == 0) {
+        glGenBuffers(1, &gpu.highlight_ebo);
+        glBindVertexArray(gpu.base.vao);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpu.highlight_ebo);
+        glBindVertexArray(0);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, gpu.highlight_ebo);
+    glBufferData(GL_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Renderer::set_residual_field(bool enabled, float scale) {
+    residual_field_enabled = enabled;
+    residual_field_scale = scale;
+}
+
+void Renderer::set_density_mode(bool enabled, float gain) {
+    density_enabled = enabled;
+    density_gain = gain;
+}
+
+void Renderer::set_time_window(bool enabled, float t_start, float t_end, bool fade) {
+    time_window_enabled = enabled;
+    time_window_start = t_start;
+    time_window_end = t_end;
+    time_window_fade = fade;
+}
+
+static void clamp_ranges(std::vector<GLint>& firsts, std::vector<GLsizei>& counts, GLsizei limit) {
+    size_t kept = 0;
+    for (size_t r = 0; r < firsts.size(); ++r) {
+        GLsizei count = std::min(counts[r], limit - firsts[r]);
+        if (count <= 0) continue;
+        firsts[kept] = firsts[r];
+        counts[kept] = count;
+        kept++;
+    }
+    firsts.resize(kept);
+    counts.resize(kept);
 }
 
 void Renderer::draw(const Math::Mat4& view, const Math::Mat4& projection, const std::vector<bool>& visibility,
-    const Math::Mat4& radar_model, const Math::Mat4& target_model, const Math::Mat4& selection_sphere_model) {
-    glUseProgram(color_shader);
-    glUniformMatrix4fv(glGetUniformLocation(color_shader, "projection"), 1, GL_FALSE, &projection.m[0]);
-    glUniformMatrix4fv(glGetUniformLocation(color_shader, "view"), 1, GL_FALSE, &view.m[0]);
-    Math::Mat4 identity_model = Math::identity();
+    const Math::Mat4& radar_model, const Math::Mat4& selection_sphere_model) {
+    // Kare başına ortak uniform'lar
+    FrameBlock frame = {};
+    memcpy(frame.view, view.m, sizeof(frame.view));
+    memcpy(frame.projection, projection.m, sizeof(frame.projection));
+    frame.time_window[0] = time_window_start;
+    frame.time_window[1] = time_window_end;
+    frame.fade_time_window = time_window_fade;
+    glBindBuffer(GL_UNIFORM_BUFFER, frame_ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameBlock), &frame);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, RenderQueue::frame_block_binding, frame_ubo);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_1D, colormap_texture);
+    glActiveTexture(GL_TEXTURE0);
+
+    // Görüş piramidi ve zaman penceresi dışında kalan parçalar hiç gönderilmez
+    Frustum frustum = extractFrustum(Math::multiply(projection, view));
+    float cull_t_start = time_window_enabled ? time_window_start : -std::numeric_limits<float>::max();
+    float cull_t_end = time_window_enabled ? time_window_end : std::numeric_limits<float>::max();
+    if (density_enabled) draw_density(frustum, cull_t_start, cull_t_end, visibility);
+
+    render_queue.clear();
+    DrawUniforms scene_uniforms;
 
     // Grid, Eksenler...
-    glUniformMatrix4fv(glGetUniformLocation(color_shader, "model"), 1, GL_FALSE, &identity_model.m[0]);
-    glLineWidth(1.0f);
-    glBindVertexArray(grid.vao);
-    glDrawArrays(grid.draw_mode, 0, grid.vertex_count);
-    glLineWidth(2.5f);
-    glBindVertexArray(axes.vao);
-    glDrawArrays(axes.draw_mode, 0, axes.vertex_count);
+    render_queue.set_group("Izgara");
+    render_queue.draw_arrays({ color_shader, grid.vao, grid.draw_mode, 1.0f }, scene_uniforms, 0, grid.vertex_count);
+    render_queue.draw_arrays({ color_shader, axes.vao, axes.draw_mode, 2.5f }, scene_uniforms, 0, axes.vertex_count);
 
     // Yörünge çizgileri ve noktaları
-    for (size_t i = 0; i < dataset_render_objects.size(); ++i) {
-        if (!visibility[i] || dataset_render_objects[i].vertex_count == 0) continue;
-        glBindVertexArray(dataset_render_objects[i].vao);
-        if (dataset_render_objects[i].draw_mode == GL_POINTS) {
-            glPointSize(5.0f);
+    Math::Vec3 eye = Math::camera_position(view);
+    float pixels_per_unit_at_1m = projection.m[5] * fbo_height * 0.5f;
+    if (Math::is_orthographic(projection)) {
+        // Ortografik görünümde piksel başına dünya birimi uzaklıktan bağımsızdır. LOD seçimi perspektif
+        // varsayar; kamera bakış ekseninin çok gerisine alınırsa uzaklık sahne içinde neredeyse sabit kalır
+        // ve ölçek bu uzaklıkla çarpılarak aynı ekran hatası elde edilir.
+        float back = 200.0f / std::fabs(projection.m[10]);
+        eye.x += view.m[2] * back;
+        eye.y += view.m[6] * back;
+        eye.z += view.m[10] * back;
+        pixels_per_unit_at_1m *= back;
+    }
+    render_queue.set_group("Veri Setleri");
+    for (size_t i = 0; i < dataset_gpu.size(); ++i) {
+        const DatasetGpu& gpu = dataset_gpu[i];
+        if (i >= visibility.size() || !visibility[i] || gpu.base.vertex_count == 0) continue;
+        DrawUniforms uniforms;
+        uniforms.object_id = (GLuint)(i + 1);
+        std::copy(gpu.color, gpu.color + 3, uniforms.object_color);
+        // Zaman verisi olmayan veri setleri pencereden etkilenmez
+        uniforms.use_time_window = time_window_enabled && gpu.time_count >= gpu.base.vertex_count;
+
+        if (!gpu.is_line_series) {
+            // Yoğunluk haritası açıkken nokta bulutları yalnızca harita olarak görünür
+            if (density_enabled) continue;
+            // Boyut ve renk nokta başına özniteliklerden
+            GLsizei count = drawable_point_count(gpu);
+            const PointStyle& style = gpu.style;
+            uniforms.use_color_attribute = gpu.color_attribute >= 0;
+            uniforms.use_size_attribute = gpu.size_attribute >= 0;
+            uniforms.round_points = 1;
+            uniforms.color_range[0] = style.color_min;
+            uniforms.color_range[1] = style.color_max;
+            uniforms.size_range[0] = style.size_min;
+            uniforms.size_range[1] = style.size_max;
+            uniforms.point_size_px[0] = style.point_size_min_px;
+            uniforms.point_size_px[1] = style.point_size_max_px;
+            lod_firsts.clear();
+            lod_counts.clear();
+            gpu.geometry.point_chunks.select_ranges(frustum, cull_t_start, cull_t_end, (size_t)count, lod_firsts, lod_counts);
+            DrawState state = { dataset_shader, gpu.base.vao, GL_POINTS, 1.0f, gpu.chunk_texture, true };
+            render_queue.multi_draw_arrays(state, uniforms, lod_firsts, lod_counts);
+            continue;
         }
-        else {
-            glLineWidth(2.0f);
+        if (gpu.geometry.lod.chunks.empty()) continue;
+        lod_firsts.clear();
+        lod_counts.clear();
+        coarse_firsts.clear();
+        coarse_counts.clear();
+        gpu.geometry.lod.select_ranges(eye, pixels_per_unit_at_1m, lod_max_error_px, frustum, cull_t_start, cull_t_end,
+            lod_firsts, lod_counts, coarse_firsts, coarse_counts);
+        // Yükleme sürerken henüz tampona ulaşmamış köşeler çizilmez
+        clamp_ranges(lod_firsts, lod_counts, gpu.base.vertex_count);
+        clamp_ranges(coarse_firsts, coarse_counts, gpu.coarse.vertex_count);
+        render_queue.multi_draw_arrays({ dataset_shader, gpu.base.vao, GL_LINE_STRIP, 2.0f, gpu.chunk_texture }, uniforms, lod_firsts, lod_counts);
+        uniforms.pick_index_flag = coarse_pick_flag;
+        render_queue.multi_draw_arrays({ dataset_shader, gpu.coarse.vao, GL_LINE_STRIP, 2.0f, gpu.chunk_texture }, uniforms, coarse_firsts, coarse_counts);
+    }
+
+    // Sorgu vurgusu: yalnızca yüklenmiş köşeleri gösteren indeksler çizilir. Vurgu aynı köşeleri aynı dönüşümle
+    // çizdiğinden derinliği normal çizimle eşittir; GL_LESS ile elenmemesi için GL_LEQUAL kullanılır
+    render_queue.set_group("Sorgu");
+    for (size_t i = 0; i < dataset_gpu.size(); ++i) {
+        const DatasetGpu& gpu = dataset_gpu[i];
+        if (i >= visibility.size() || !visibility[i] || gpu.highlight_indices.empty()) continue;
+        GLsizei count = (GLsizei)(std::lower_bound(gpu.highlight_indices.begin(), gpu.highlight_indices.end(), (uint32_t)gpu.base.vertex_count) - gpu.highlight_indices.begin());
+        DrawUniforms uniforms;
+        uniforms.object_id = (GLuint)(i + 1);
+        uniforms.object_color[0] = 1.0f;
+        uniforms.object_color[1] = 0.9f;
+        uniforms.object_color[2] = 0.1f;
+        uniforms.use_time_window = time_window_enabled && gpu.time_count >= gpu.base.vertex_count;
+        uniforms.round_points = 1;
+        uniforms.point_size_px[0] = uniforms.point_size_px[1] = 7.0f;
+        render_queue.draw_elements({ dataset_shader, gpu.base.vao, GL_POINTS, 1.0f, gpu.chunk_texture, true, GL_LEQUAL }, uniforms, count);
+    }
+
+    // Toplu artık alanı: veri seti başına tek örneklemeli çizim, zaman süzgeci shader'da
+    if (residual_field_enabled) {
+        render_queue.set_group("Artik Alani");
+        float color_max = 0.0f;
+        for (const auto& gpu : dataset_gpu) color_max = std::max(color_max, gpu.residual_p99);
+        DrawUniforms uniforms;
+        uniforms.use_time_window = time_window_enabled;
+        uniforms.color_range[1] = std::max(color_max, 1e-3f);
+        uniforms.residual_scale = residual_field_scale;
+        for (size_t i = 0; i < dataset_gpu.size(); ++i) {
+            const DatasetGpu& gpu = dataset_gpu[i];
+            if (i >= visibility.size() || !visibility[i]) continue;
+            render_queue.draw_arrays_instanced({ residual_shader, gpu.residuals.vao, GL_LINES, 1.0f }, uniforms, 0, 2, gpu.residuals.vertex_count);
         }
-        glDrawArrays(dataset_render_objects[i].draw_mode, 0, dataset_render_objects[i].vertex_count);
     }
 
     // Radar Modeli
-    glUniformMatrix4fv(glGetUniformLocation(color_shader, "model"), 1, GL_FALSE, &radar_model.m[0]);
-    glBindVertexArray(radar_obj.vao);
-    glDrawArrays(radar_obj.draw_mode, 0, radar_obj.vertex_count);
+    render_queue.set_group("Modeller");
+    DrawUniforms model_uniforms;
+    model_uniforms.model = radar_model;
+    render_queue.draw_arrays({ color_shader, radar_obj.vao, radar_obj.draw_mode, 1.0f }, model_uniforms, 0, radar_obj.vertex_count);
 
-    // Hedef Modeli
-    glUniformMatrix4fv(glGetUniformLocation(color_shader, "model"), 1, GL_FALSE, &target_model.m[0]);
-    glBindVertexArray(target_obj.vao);
-    glDrawElements(target_obj.draw_mode, target_obj.vertex_count, GL_UNSIGNED_INT, 0);
+    // Hedef Modelleri
+    render_queue.draw_elements_instanced({ target_shader, target_obj.vao, target_obj.draw_mode, 1.0f }, scene_uniforms, target_obj.vertex_count, target_instance_count);
 
     // Seçim Küresi
     if (selection_sphere_model.m[0] != 0 || selection_sphere_model.m[5] != 0) { // Geçerli bir model mi diye kontrol
-        glUniformMatrix4fv(glGetUniformLocation(color_shader, "model"), 1, GL_FALSE, &selection_sphere_model.m[0]);
-        glBindVertexArray(selection_sphere.vao);
-        glDrawElements(selection_sphere.draw_mode, selection_sphere.vertex_count, GL_UNSIGNED_INT, 0);
+        model_uniforms.model = selection_sphere_model;
+        render_queue.draw_elements({ color_shader, selection_sphere.vao, selection_sphere.draw_mode, 1.0f }, model_uniforms, selection_sphere.vertex_count);
     }
 
-
     // Hata Vektörleri
     if (error_vector_obj.vertex_count > 0) {
-        glLineWidth(1.5f);
-        glUniformMatrix4fv(glGetUniformLocation(color_shader, "model"), 1, GL_FALSE, &identity_model.m[0]);
-        glBindVertexArray(error_vector_obj.vao);
-        glDrawArrays(error_vector_obj.draw_mode, 0, error_vector_obj.vertex_count);
+        render_queue.set_group("Hata Vektorleri");
+        render_queue.draw_arrays({ color_shader, error_vector_obj.vao, error_vector_obj.draw_mode, 1.5f }, scene_uniforms, error_vector_first, error_vector_obj.vertex_count);
+    }
+
+    render_queue.submit(profiler);
+    if (error_vector_obj.vertex_count > 0) error_vector_ring.fence();
+    if (target_instance_count > 0) target_instance_ring.fence();
+}
+
+
+GLsizei Renderer::drawable_point_count(const DatasetGpu& gpu) {
+    // Öznitelik tamponu henüz yetişmediyse eksik kısım çizilmez
+    GLsizei count = gpu.base.vertex_count;
+    if (gpu.color_attribute >= 0) count = std::min(count, (GLsizei)(gpu.attributes[gpu.color_attribute].buffer.size() / sizeof(float)));
+    if (gpu.size_attribute >= 0) count = std::min(count, (GLsizei)(gpu.attributes[gpu.size_attribute].buffer.size() / sizeof(float)));
+    return count;
+}
+
+void Renderer::draw_density(const Frustum& frustum, float cull_t_start, float cull_t_end, const std::vector<bool>& visibility) {
+    if (density_width != fbo_width || density_height != fbo_height) {
+        destroy_density_target();
+        create_density_target(fbo_width, fbo_height);
+    }
+
+    // Noktalar normal çizimdeki kırpma aralıklarıyla, 1 piksel boyutunda ve derinlik testi olmadan sayılır
+    render_queue.clear();
+    render_queue.set_group("Yogunluk");
+    DrawUniforms uniforms;
+    for (size_t i = 0; i < dataset_gpu.size(); ++i) {
+        const DatasetGpu& gpu = dataset_gpu[i];
+        if (i >= visibility.size() || !visibility[i] || gpu.is_line_series || gpu.base.vertex_count == 0) continue;
+        uniforms.use_time_window = time_window_enabled && gpu.time_count >= gpu.base.vertex_count;
+        lod_firsts.clear();
+        lod_counts.clear();
+        gpu.geometry.point_chunks.select_ranges(frustum, cull_t_start, cull_t_end, (size_t)drawable_point_count(gpu), lod_firsts, lod_counts);
+        render_queue.multi_draw_arrays({ density_shader, gpu.base.vao, GL_POINTS, 1.0f, gpu.chunk_texture, true }, uniforms, lod_firsts, lod_counts);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, density_fbo);
+    glViewport(0, 0, density_width, density_height);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    render_queue.submit(profiler);
+
+    // Ortalama yoğunluk için mip zinciri; en üst seviye tek piksellik ortalamadır
+    if (profiler) profiler->gpu_begin("Yogunluk Birlestirme");
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, density_texture);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glActiveTexture(GL_TEXTURE0);
+
+    // Harita sahnenin arkasına çizilir; sonraki çizimler üzerine gelir
+    glBindFramebuffer(GL_FRAMEBUFFER, msaa_fbo ? msaa_fbo : fbo);
+    glViewport(0, 0, fbo_width, fbo_height);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
+    glUseProgram(density_composite_shader);
+    glUniform1f(density_gain_location, density_gain);
+    glUniform1i(density_top_level_location, (int)std::floor(std::log2((float)std::max(density_width, density_height))));
+    glBindVertexArray(density_vao);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+    glEnable(GL_DEPTH_TEST);
+    if (profiler) profiler->gpu_end();
+}
+
+void Renderer::create_density_target(int width, int height) {
+    density_width = width;
+    density_height = height;
+    glGenFramebuffers(1, &density_fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, density_fbo);
+    glGenTextures(1, &density_texture);
+    glBindTexture(GL_TEXTURE_2D, density_texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, width, height, 0, GL_RED, GL_FLOAT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, density_texture, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cerr << "Yogunluk framebuffer tamamlanamadi!" << std::endl;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void Renderer::destroy_density_target() {
+    if (density_fbo) glDeleteFramebuffers(1, &density_fbo);
+    if (density_texture) glDeleteTextures(1, &density_texture);
+    density_fbo = density_texture = 0;
+    density_width = density_height = 0;
+}
+
+
+bool Renderer::update_target_instances(const std::vector<float>& matrices) {
+    // Hedefler değişmediyse (zaman ilerlemiyorken) yeniden yüklemeye gerek yok
+    if (matrices == target_instance_matrices) return false;
+    target_instance_matrices = matrices;
+    target_instance_count = (GLsizei)(matrices.size() / 16);
+    if (target_instance_count == 0) return true;
+
+    // Taban örnek (base instance) GL 3.3'te olmadığından matris öznitelikleri yazılan bölgenin ofsetine yeniden bağlanır
+    size_t offset = target_instance_ring.write(matrices.data(), matrices.size() * sizeof(float));
+    glBindVertexArray(target_obj.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, target_instance_ring.id());
+    for (GLuint column = 0; column < 4; ++column) {
+        GLuint location = 2 + column;
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, 16 * sizeof(float), (void*)(offset + column * 4 * sizeof(float)));
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
     }
+    glBindVertexArray(0);
+    return true;
 }
 
 
-void Renderer::update_error_vectors(const std::vector<std::pair<DataPoint, DataPoint>>& vectors) {
+bool Renderer::update_error_vectors(const std::vector<std::pair<DataPoint, DataPoint>>& vectors) {
     if (vectors.empty()) {
+        bool changed = error_vector_obj.vertex_count > 0;
         error_vector_obj.vertex_count = 0;
-        return;
+        error_vector_vertices.clear();
+        return changed;
     }
     std::vector<float> vertices;
+    vertices.reserve(vectors.size() * 12);
     for (const auto& vec : vectors) {
         const auto& p1 = vec.first;
         const auto& p2 = vec.second;
         vertices.insert(vertices.end(), { (float)p1.x, (float)p1.z, (float)-p1.y, 1.0f, 1.0f, 1.0f });
         vertices.insert(vertices.end(), { (float)p2.x, (float)p2.z, (float)-p2.y, 1.0f, 1.0f, 1.0f });
     }
-    glBindVertexArray(error_vector_obj.vao);
-    glBindBuffer(GL_ARRAY_BUFFER, error_vector_obj.vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_DYNAMIC_DRAW);
-    error_vector_obj.vertex_count = static_cast<GLsizei>(vertices.size() / 6);
-    glBindVertexArray(0);
+    // Vektörler değişmediyse (zaman ilerlemiyorken) yeniden yüklemeye gerek yok
+    if (vertices == error_vector_vertices) return false;
+    error_vector_vertices.swap(vertices);
+
+    size_t offset = error_vector_ring.write(error_vector_vertices.data(), error_vector_vertices.size() * sizeof(float));
+    error_vector_first = (GLint)(offset / (6 * sizeof(float)));
+    error_vector_obj.vertex_count = static_cast<GLsizei>(error_vector_vertices.size() / 6);
+    return true;
 }
 
 
-void Renderer::create_fbo(int width, int height) {
+void Renderer::create_fbo(int width, int height, int samples) {
+    fbo_width = width;
+    fbo_height = height;
+    fbo_samples = samples;
+    const GLenum draw_buffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+
+    // Çözümlenmiş (tek örnekli) hedef: arayüzde gösterilen doku ve seçim için okunan ID eki
     glGenFramebuffers(1, &fbo);
     glBindFramebuffer(GL_FRAMEBUFFER, fbo);
     glGenTextures(1, &fbo_texture);
@@ -366,20 +1266,169 @@ void Renderer::create_fbo(int width, int height) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, fbo_texture, 0);
+    // Seçim için (veri seti, nokta) ID'lerini tutan tamsayı eki
+    glGenTextures(1, &fbo_id_texture);
+    glBindTexture(GL_TEXTURE_2D, fbo_id_texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG32UI, width, height, 0, GL_RG_INTEGER, GL_UNSIGNED_INT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, fbo_id_texture, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glDrawBuffers(2, draw_buffers);
     glGenRenderbuffers(1, &rbo_depth);
     glBindRenderbuffer(GL_RENDERBUFFER, rbo_depth);
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, rbo_depth);
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
         std::cerr << "Framebuffer tamamlanamadi!" << std::endl;
+
+    // Çok örnekli çizim hedefi (MSAA): sahne buraya çizilir, unbind_fbo'da yukarıdakine çözülür
+    if (samples > 1) {
+        glGenFramebuffers(1, &msaa_fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, msaa_fbo);
+        glGenRenderbuffers(3, msaa_rbos);
+        const GLenum formats[3] = { GL_RGB8, GL_RG32UI, GL_DEPTH_COMPONENT24 };
+        const GLenum attachments[3] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_DEPTH_ATTACHMENT };
+        for (int a = 0; a < 3; ++a) {
+            glBindRenderbuffer(GL_RENDERBUFFER, msaa_rbos[a]);
+            glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, formats[a], width, height);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachments[a], GL_RENDERBUFFER, msaa_rbos[a]);
+        }
+        glDrawBuffers(2, draw_buffers);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            std::cerr << "MSAA framebuffer tamamlanamadi!" << std::endl;
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+void Renderer::destroy_fbo() {
+    if (fbo) glDeleteFramebuffers(1, &fbo);
+    if (fbo_texture) glDeleteTextures(1, &fbo_texture);
+    if (fbo_id_texture) glDeleteTextures(1, &fbo_id_texture);
+    if (rbo_depth) glDeleteRenderbuffers(1, &rbo_depth);
+    if (msaa_fbo) glDeleteFramebuffers(1, &msaa_fbo);
+    for (auto& rbo : msaa_rbos) {
+        if (rbo) glDeleteRenderbuffers(1, &rbo);
+        rbo = 0;
+    }
+    fbo = fbo_texture = fbo_id_texture = rbo_depth = msaa_fbo = 0;
+}
+
+bool Renderer::resize_fbo(int width, int height, int samples) {
+    width = std::max(width, 1);
+    height = std::max(height, 1);
+    samples = std::clamp(samples, 1, max_fbo_samples);
+    if (width == fbo_width && height == fbo_height && samples == fbo_samples) return false;
+    destroy_fbo();
+    create_fbo(width, height, samples);
+    return true;
+}
+
 void Renderer::bind_fbo() {
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, msaa_fbo ? msaa_fbo : fbo);
+    glViewport(0, 0, fbo_width, fbo_height);
 }
 
 void Renderer::unbind_fbo() {
+    if (msaa_fbo) {
+        // Renk eki örnekler ortalanarak, ID eki tek örnek seçilerek (tamsayı) çözülür
+        const GLenum draw_color[2] = { GL_COLOR_ATTACHMENT0, GL_NONE };
+        const GLenum draw_id[2] = { GL_NONE, GL_COLOR_ATTACHMENT1 };
+        const GLenum draw_both[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+        if (profiler) profiler->gpu_begin("MSAA Cozumleme");
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, msaa_fbo);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        glDrawBuffers(2, draw_color);
+        glBlitFramebuffer(0, 0, fbo_width, fbo_height, 0, 0, fbo_width, fbo_height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glReadBuffer(GL_COLOR_ATTACHMENT1);
+        glDrawBuffers(2, draw_id);
+        glBlitFramebuffer(0, 0, fbo_width, fbo_height, 0, 0, fbo_width, fbo_height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        glDrawBuffers(2, draw_both);
+        if (profiler) profiler->gpu_end();
+    }
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+void Renderer::clear_fbo(float r, float g, float b) {
+    // Tamsayı ekini glClear ile temizlemek tanımsızdır, her ek kendi tipinde temizlenir.
+    const GLfloat clear_color[4] = { r, g, b, 1.0f };
+    const GLuint clear_id[4] = { 0, 0, 0, 0 };
+    glClearBufferfv(GL_COLOR, 0, clear_color);
+    glClearBufferuiv(GL_COLOR, 1, clear_id);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+bool Renderer::request_pick(int fbo_x, int fbo_y, int radius, uint32_t tag) {
+    // Halka doluysa en eski istek tamamlanana kadar yenisi alınmaz (GPU'yu bekletmemek için)
+    if (pick_pending == pick_ring_size) return false;
+
+    int x0 = std::max(0, fbo_x - radius), y0 = std::max(0, fbo_y - radius);
+    int x1 = std::min(fbo_width - 1, fbo_x + radius), y1 = std::min(fbo_height - 1, fbo_y + radius);
+    if (x0 > x1 || y0 > y1) return false;
+
+    PickReadback& readback = pick_ring[(pick_head + pick_pending) % pick_ring_size];
+    readback.width = x1 - x0 + 1;
+    readback.height = y1 - y0 + 1;
+    readback.center_x = fbo_x - x0;
+    readback.center_y = fbo_y - y0;
+    readback.tag = tag;
+
+    if (readback.pbo == 0) glGenBuffers(1, &readback.pbo);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+    glBufferData(GL_PIXEL_PACK_BUFFER, readback.width * readback.height * 2 * sizeof(GLuint), NULL, GL_STREAM_READ);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glReadBuffer(GL_COLOR_ATTACHMENT1);
+    glReadPixels(x0, y0, readback.width, readback.height, GL_RG_INTEGER, GL_UNSIGNED_INT, (void*)0);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    pick_pending++;
+    return true;
+}
+
+bool Renderer::poll_pick(GpuPickResult& result) {
+    if (pick_pending == 0) return false;
+    PickReadback& readback = pick_ring[pick_head];
+    GLenum status = glClientWaitSync(readback.fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) return false;
+    glDeleteSync(readback.fence);
+    readback.fence = nullptr;
+
+    result = GpuPickResult{};
+    result.tag = readback.tag;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+    const GLuint* ids = (const GLuint*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, readback.width * readback.height * 2 * sizeof(GLuint), GL_MAP_READ_BIT);
+    if (ids) {
+        // Bölge içinde merkeze en yakın, seçilebilir nesneye ait pikseli bul
+        int best_dist_sq = std::numeric_limits<int>::max();
+        for (int y = 0; y < readback.height; ++y) {
+            for (int x = 0; x < readback.width; ++x) {
+                const GLuint* id = ids + 2 * (y * readback.width + x);
+                if (id[0] == 0) continue;
+                int dx = x - readback.center_x, dy = y - readback.center_y;
+                if (dx * dx + dy * dy < best_dist_sq) {
+                    best_dist_sq = dx * dx + dy * dy;
+                    result.dataset_idx = id[0] - 1;
+                    result.point_idx = id[1];
+                }
+            }
+        }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    // Kaba detay seviyelerinin köşeleri orijinal nokta indeksine çevrilir
+    if (result.point_idx != GpuPickResult::npos && (result.point_idx & coarse_pick_flag)) {
+        size_t vertex_idx = result.point_idx & ~(size_t)coarse_pick_flag;
+        const auto* lod = result.dataset_idx < dataset_gpu.size() ? &dataset_gpu[result.dataset_idx].geometry.lod : nullptr;
+        result.point_idx = lod && vertex_idx < lod->coarse_source_index.size() ? lod->coarse_source_index[vertex_idx] : GpuPickResult::npos;
+    }
+
+    pick_head = (pick_head + 1) % pick_ring_size;
+    pick_pending--;
+    return true;
+}
@@ -3,9 +3,19 @@
 #define GLFW_INCLUDE_NONE
 #include <glad/glad.h>
 #include <vector>
+#include <string>
 #include <utility>
+#include <cstdint>
+#include <limits>
 #include "DataStructures.hpp"
+#include "Association.hpp"
 #include "Math.hpp"
+#include "TrajectoryLod.hpp"
+#include "StreamingBuffer.hpp"
+#include "VertexQuantizer.hpp"
+#include "DrawSubmission.hpp"
+#include "DatasetGeometry.hpp"
+#include "Profiler.hpp"
 
 // Çizilecek bir OpenGL nesnesini temsil eder.
 struct RenderObject {
@@ -16,36 +26,260 @@ struct RenderObject {
     void cleanup();
 };
 
+// Nokta bulutlarının öznitelik tabanlı görünümü. Öznitelik adı boşsa veri setinin sabit rengi/boyutu kullanılır.
+// Değerler [min, max] aralığına göre renk haritasına ve [point_size_min_px, point_size_max_px] boyutuna eşlenir.
+struct PointStyle {
+    std::string color_attribute;
+    std::string size_attribute;
+    float color_min = 0.0f, color_max = 1.0f;
+    float size_min = 0.0f, size_max = 1.0f;
+    float point_size_min_px = 5.0f;  // Boyut özniteliği yoksa sabit boyut
+    float point_size_max_px = 12.0f;
+};
+
+// ID tamponundan asenkron okunan seçim sonucu. Nokta bulunamazsa indeksler npos kalır.
+struct GpuPickResult {
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+    uint32_t tag = 0;
+    size_t dataset_idx = npos;
+    size_t point_idx = npos;
+};
+
 class Renderer {
 public:
     Renderer();
     ~Renderer();
 
-    void initialize(const std::vector<SearchableDataset>& datasets, float grid_size);
+    // Veri setleri burada yüklenmez; sync_dataset ile hemen ya da queue_dataset ile kademeli olarak eklenir.
+    void initialize(size_t dataset_count, float grid_size);
     void draw(const Math::Mat4& view, const Math::Mat4& projection, const std::vector<bool>& visibility,
-        const Math::Mat4& radar_model, const Math::Mat4& target_model, const Math::Mat4& selection_sphere_model);
-    void update_error_vectors(const std::vector<std::pair<DataPoint, DataPoint>>& vectors);
+        const Math::Mat4& radar_model, const Math::Mat4& selection_sphere_model);
+    // Hedef modellerinin örnek başına model matrisleri (hedef başına 16 float, TargetAnimator çıktısı).
+    // Matrisler bir önceki çağrıdakinden farklıysa true döner.
+    bool update_target_instances(const std::vector<float>& matrices);
+    // Vektörler bir önceki çağrıdakinden farklıysa (sahnenin yeniden çizilmesi gerekiyorsa) true döner.
+    bool update_error_vectors(const std::vector<std::pair<DataPoint, DataPoint>>& vectors);
+
+    // Veri setinin GPU kopyasını günceller: ilk çağrıda tamponları oluşturur, sonrakilerde yalnızca
+    // son çağrıdan beri eklenen noktaları yükler (büyüyen/canlı veri setleri için).
+    void sync_dataset(size_t dataset_idx, const SearchableDataset& dataset);
+
+    // Arka planda hazırlanmış (DatasetGeometry::update) köşeleri yükleme kuyruğuna alır. Veri, upload_pending
+    // çağrılarıyla kare başına en fazla budget_bytes olacak şekilde bir hazırlık halkası üzerinden GPU'ya kopyalanır;
+    // veri seti bu sürede yüklenen kısmıyla çizilir. upload_pending bir şey yüklediyse true döner.
+    void queue_dataset(size_t dataset_idx, const SearchableDataset& dataset, DatasetGeometry&& geometry, GeometryUpdate&& update);
+    bool upload_pending(size_t budget_bytes);
+    bool has_pending_uploads() const { return !pending_uploads.empty(); }
+    float upload_progress(size_t dataset_idx) const;  // 0: kuyrukta değil, 1: tamamlandı
+
+    // Nokta bulutları için nokta başına öznitelik akışları (zaman, menzil, artık büyüklüğü...). Her akış kendi
+    // tamponunda bir kez yüklenir (büyüyen veri setlerinde yalnızca yeni değerler eklenir); görünüm değiştirmek
+    // hiçbir tamponu yeniden oluşturmaz, yalnızca VAO'nun hangi tamponu okuduğunu değiştirir. first_changed verilirse
+    // o satırdan itibaren yüklenmiş değerler de yeniden gönderilir (örn. sonradan eşleşen ölçümlerin artıkları).
+    void upload_point_attribute(size_t dataset_idx, const std::string& name, const std::vector<float>& values, float vmin, float vmax,
+                                size_t first_changed = SIZE_MAX);
+    // Yüklenmiş akışın değer aralığını verir; akış yoksa false döner.
+    bool point_attribute_range(size_t dataset_idx, const std::string& name, float& vmin, float& vmax) const;
+    void set_point_style(size_t dataset_idx, const PointStyle& style);
 
-    // Framebuffer Object (FBO) yönetimi
-    void bind_fbo();
+    // Toplu artık alanı: her eşleşmiş ölçümden gerçek konuma, büyüklüğe göre renklendirilmiş bir çizgi.
+    // Geometri veri seti başına bir kez yüklenir (büyüyen veri setlerinde yalnızca yeni ölçümler eklenir);
+    // çizgiler scale ile uzatılabilir ve zaman penceresine shader'da uyar. Yüklenmiş kısımda first_changed satırından
+    // itibaren eşleşmeler değiştiyse alan baştan kurulur.
+    void upload_residual_field(size_t dataset_idx, const SearchableDataset& dataset, const AssociationTable& table,
+                               size_t first_changed = SIZE_MAX);
+    void set_residual_field(bool enabled, float scale);
+
+    // Sorgu sonucu vurgusu: verilen nokta indeksleri (artan sırada) veri setinin köşe tamponundan bir indeks
+    // tamponuyla, normal çizimin üzerine büyük ve sarı noktalar olarak çizilir. Boş liste vurguyu kaldırır.
+    void set_highlight(size_t dataset_idx, const std::vector<uint32_t>& indices);
+
+    // Yoğunluk haritası: nokta bulutları tek tek çizilmek yerine FBO çözünürlüğündeki kayan noktalı bir dokuda
+    // toplamalı karıştırmayla sayılır ve log ile sıkıştırılıp renk haritasıyla sahnenin arkasına çizilir.
+    // Maliyet nokta başına tek piksel yazımıdır; gain, ortalama yoğunluğun kaç katının doygun renge eşleneceğidir.
+    // Harita olarak çizilen noktalar GPU ID tamponunda görünmez (CPU seçimi etkilenmez).
+    void set_density_mode(bool enabled, float gain);
+
+    // Zaman penceresi: [t_start, t_end] dışındaki örnekler shader'da atılır, fade açıksa pencere içindekiler
+    // eski uca doğru soluklaşır. Zaman akışları yüklemede bir kez gönderildiğinden her kare yalnızca uniform değişir.
+    void set_time_window(bool enabled, float t_start, float t_end, bool fade);
+
+    // Framebuffer Object (FBO) yönetimi. FBO görüntü alanı boyutunu izler; boyut veya örnek sayısı
+    // değiştiyse yeniden oluşturulur ve true döner. samples > 1 ise sahne çok örnekli bir hedefe çizilir
+    // ve unbind_fbo'da gösterilen dokuya çözülür.
+    bool resize_fbo(int width, int height, int samples);
+    void bind_fbo();    // Görüntü alanını da FBO boyutuna ayarlar
     void unbind_fbo();
+    void clear_fbo(float r, float g, float b);
     GLuint get_fbo_texture() const { return fbo_texture; }
+    int get_fbo_width() const { return fbo_width; }
+    int get_fbo_height() const { return fbo_height; }
+    int get_max_fbo_samples() const { return max_fbo_samples; }
+
+    // GPU ID tamponu ile seçim: FBO pikselleri etrafında (2*radius+1)^2'lik bir bölge PBO'ya kopyalanır,
+    // sonuç birkaç kare sonra poll_pick ile bekletmeden alınır.
+    bool request_pick(int fbo_x, int fbo_y, int radius, uint32_t tag);
+    bool poll_pick(GpuPickResult& result);
+    bool has_pending_picks() const { return pick_pending > 0; }
+
+    // Verilirse çizim grupları ve MSAA çözümlemesi GPU zamanlayıcılarıyla ölçülür
+    void set_profiler(Profiler* frame_profiler) { profiler = frame_profiler; }
+    size_t draw_item_count() const { return render_queue.item_count(); }
+    size_t draw_state_changes() const { return render_queue.state_changes(); }
 
 private:
     GLuint color_shader;
+    GLuint dataset_shader;  // Sıkıştırılmış köşeli veri setleri
+    GLuint residual_shader; // Toplu artık alanı (örneklemeli çizgiler)
+    GLuint target_shader;   // Örneklemeli hedef modelleri
+    GLuint density_shader;  // Nokta bulutlarının yoğunluk dokusuna sayımı
+    GLuint density_composite_shader;
+    GLuint colormap_texture = 0;
+
+    // Çizim gönderim katmanı ve kare başına uniform tamponu (kamera, zaman penceresi)
+    RenderQueue render_queue;
+    GLuint frame_ubo = 0;
+    Profiler* profiler = nullptr;
 
     // Sahne Nesneleri
     RenderObject grid, axes, radar_obj, target_obj, selection_sphere;
-    std::vector<RenderObject> dataset_render_objects;
     RenderObject error_vector_obj;
 
+    // Artık alanının örnek başına verisi
+    struct ResidualInstance {
+        float start[3];
+        float end[3];
+        float magnitude;
+        float time;
+    };
+
+    struct PointAttribute {
+        std::string name;
+        GrowableBuffer buffer; // Nokta başına bir float
+        float min = 0.0f, max = 1.0f;
+    };
+
+    // Bir veri setinin GPU tarafı. Köşeler 8 baytlık QuantizedVertex olarak tutulur ve
+    // tamponlar yalnızca sonuna ekleme ile büyür.
+    struct DatasetGpu {
+        RenderObject base;          // Noktalar / yörüngenin 0. seviyesi (köşe indeksi = nokta indeksi)
+        RenderObject coarse;        // Kaba detay seviyelerinin köşeleri (yalnızca çizgi serileri)
+        GrowableBuffer base_buffer, coarse_buffer;
+        VertexQuantizer quantizer;
+        GrowableBuffer chunk_buffer; // Parça tablosu (QuantChunk dizisi)
+        GLuint chunk_texture = 0;    // chunk_buffer'ı gösteren doku tamponu
+        DatasetGeometry geometry;    // LOD piramidi, kırpma parçaları ve sıkıştırıcı (CPU tarafı)
+        float color[3] = { 1.0f, 1.0f, 1.0f }; // object_color uniform'u
+        std::vector<PointAttribute> attributes;
+        PointStyle style;
+        int color_attribute = -1, size_attribute = -1; // attributes içindeki indeks
+        GrowableBuffer time_buffer, coarse_time_buffer;  // Köşe başına zaman (s)
+        GLsizei time_count = 0;
+        bool is_line_series = false;
+        RenderObject residuals;             // vertex_count: örnek sayısı
+        GrowableBuffer residual_buffer;     // ResidualInstance dizisi
+        size_t residual_points = 0;         // Artık alanı için işlenmiş ölçüm sayısı
+        std::vector<float> residual_magnitudes; // Yüklenmiş tüm örneklerin büyüklükleri (sırasız, yüzdelik için)
+        float residual_p99 = 0.0f;
+        GLuint highlight_ebo = 0;           // Vurgulanan noktaların indeksleri (base.vao'ya bağlı)
+        std::vector<uint32_t> highlight_indices;
+        bool pending_counts = false; // Hazırlık kopyaları sonrası köşe sayıları güncellenecek
+        // VAO'ların ve parça dokusunun bağlı olduğu tampon adları (tampon büyürken ad değişebilir)
+        GLuint bound_base = 0, bound_coarse = 0, bound_time = 0, bound_coarse_time = 0, bound_chunks = 0;
+    };
+    std::vector<DatasetGpu> dataset_gpu;
+
+    // Kademeli yükleme: her güncelleme sırayla akışlara bölünür. Zamanlar köşelerden önce yüklenir ki
+    // çizilebilen her köşenin zamanı hazır olsun; parça tablosu hepsinden önce gelir.
+    enum UploadStream { UPLOAD_CHUNKS = 0, UPLOAD_COARSE_TIMES, UPLOAD_COARSE_VERTICES, UPLOAD_TIMES, UPLOAD_BASE_VERTICES, upload_stream_count };
+    struct PendingUpload {
+        size_t dataset_idx = 0;
+        GeometryUpdate update;
+        int stream = 0;             // Sıradaki akış
+        size_t stream_offset = 0;   // Akışın yüklenmiş bayt sayısı
+        size_t done_bytes = 0;
+    };
+    struct StagedCopy {
+        size_t dataset_idx;
+        int stream;
+        size_t offset, bytes;       // Hazırlık bölgesi içinde
+    };
+    std::vector<PendingUpload> pending_uploads;
+    StreamRing upload_ring;
+    std::vector<uint8_t> staging_bytes;
+    std::vector<StagedCopy> staged_copies;
+    std::vector<GLint> lod_firsts, coarse_firsts;
+    std::vector<GLsizei> lod_counts, coarse_counts;
+    float lod_max_error_px = 1.0f;
+
+    bool residual_field_enabled = false;
+    float residual_field_scale = 1.0f;
+
+    // Yoğunluk haritası hedefi (R32F, FBO boyutunda) ve birleştirme için boş VAO
+    bool density_enabled = false;
+    float density_gain = 32.0f;
+    GLuint density_fbo = 0, density_texture = 0, density_vao = 0;
+    int density_width = 0, density_height = 0;
+    GLint density_gain_location = -1, density_top_level_location = -1;
+
+    bool time_window_enabled = false, time_window_fade = false;
+    float time_window_start = 0.0f, time_window_end = 0.0f;
+
+    // Kaba seviye köşelerinin ID tamponundaki indeksleri bu bitle işaretlenir
+    static constexpr GLuint coarse_pick_flag = 0x80000000u;
+
+    // Hedef model matrisleri, oynatma sırasında her karede değiştiği için halka tampon üzerinden akıtılır
+    StreamRing target_instance_ring;
+    GLsizei target_instance_count = 0;
+    std::vector<float> target_instance_matrices;
+
+    // Hata vektörleri her karede değişebildiği için halka tampon üzerinden akıtılır
+    StreamRing error_vector_ring;
+    GLint error_vector_first = 0;
+    std::vector<float> error_vector_vertices;
+
     // FBO
-    GLuint fbo = 0, fbo_texture = 0, rbo_depth = 0;
+    GLuint fbo = 0, fbo_texture = 0, fbo_id_texture = 0, rbo_depth = 0;
+    GLuint msaa_fbo = 0, msaa_rbos[3] = {};  // Renk, ID, derinlik
+    int fbo_width = 0, fbo_height = 0, fbo_samples = 1;
+    int max_fbo_samples = 1;
+
+    // ID tamponu okuma halkası (PBO + fence)
+    struct PickReadback {
+        GLuint pbo = 0;
+        GLsync fence = nullptr;
+        int width = 0, height = 0;
+        int center_x = 0, center_y = 0;
+        uint32_t tag = 0;
+    };
+    static constexpr int pick_ring_size = 3;
+    PickReadback pick_ring[pick_ring_size];
+    int pick_head = 0, pick_pending = 0;
 
     void setup_shaders();
-    void create_scene_objects(const std::vector<SearchableDataset>& datasets, float grid_size);
+    void create_colormap();
+    void apply_point_style(DatasetGpu& gpu);
+    void create_scene_objects(float grid_size);
+    DatasetGpu& dataset_slot(size_t dataset_idx, const SearchableDataset& dataset);
+    void begin_upload(PendingUpload& upload);
+    // Sıradaki akıştan en fazla budget_bytes yükler (staging verilirse hazırlık tamponuna ekler). Akış kalmadıysa false döner.
+    bool upload_step(PendingUpload& upload, size_t budget_bytes, std::vector<uint8_t>* staging);
+    void finish_pending_upload(size_t dataset_idx);
+    void update_dataset_counts(DatasetGpu& gpu);
+    void refresh_dataset_bindings(DatasetGpu& gpu);
+    static GrowableBuffer& stream_buffer(DatasetGpu& gpu, int stream);
+    // Akışın yüklenecek verisi, eleman boyutu ve tampondaki ilk elemanı
+    static void stream_data(const GeometryUpdate& update, int stream, const void*& data, size_t& bytes, size_t& element, size_t& first);
     void setup_render_object(RenderObject& object, const std::vector<float>& vertices, GLenum draw_mode, GLenum usage = GL_STATIC_DRAW);
+    void bind_vertex_attributes(RenderObject& object, GLuint buffer);
+    void bind_quantized_attributes(RenderObject& object, GLuint buffer);
+    void bind_float_attribute(RenderObject& object, GLuint location, GLuint buffer);
     void setup_indexed_render_object(RenderObject& object, const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
-    void create_fbo(int width, int height);
+    void create_fbo(int width, int height, int samples);
+    void destroy_fbo();
+    static GLsizei drawable_point_count(const DatasetGpu& gpu);
+    void draw_density(const Frustum& frustum, float cull_t_start, float cull_t_end, const std::vector<bool>& visibility);
+    void create_density_target(int width, int height);
+    void destroy_density_target();
 };
 
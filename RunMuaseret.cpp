@@ -10,12 +10,55 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <string>
+#include <cstdint>
 #include "CreateSimpleScenario.hpp"
 #include "prepareMuaseretInputs.hpp"
 #include "3Dplotter.hpp"
 
-int main() {
+static const char* usage =
+    "Kullanim: Adab-I [kayit.csv] | --canli <port> | --izle <kayit.csv> [port]";
+
+// Komut satırındaki UDP portunu doğrular (1-65535); geçersizse kullanım bilgisiyle hata fırlatır
+static uint16_t parse_port(const std::string& text) {
+    size_t used = 0;
+    long value = -1;
+    try {
+        value = std::stol(text, &used);
+    }
+    catch (const std::exception&) {
+        used = 0;
+    }
+    if (used != text.size() || value < 1 || value > 65535) {
+        throw std::invalid_argument("Gecersiz port '" + text + "' (1-65535 olmali). " + usage);
+    }
+    return (uint16_t)value;
+}
+
+int main(int argc, char** argv) {
     try {
+        // "--canli <port>": senaryo yerine localhost UDP'den gelen canlı verileri izle
+        if (argc >= 3 && std::string(argv[1]) == "--canli") {
+            plotLive(parse_port(argv[2]));
+            return 0;
+        }
+        // "--izle <kayit.csv> [port]": yazılmakta olan senaryo kaydını izle (isteğe bağlı olarak UDP ile birlikte)
+        if (argc >= 3 && std::string(argv[1]) == "--izle") {
+            plotLive(argc >= 4 ? parse_port(argv[3]) : 0, argv[2]);
+            return 0;
+        }
+        // "<kayit.csv>": kaydedilmiş senaryoyu yeniden üretmeden aç; gerçek yörüngenin sütun istatistikleri
+        // kaydın yanındaki önbellekten okunur
+        if (argc == 2 && std::string(argv[1]).rfind("--", 0) != 0) {
+            SearchableDataset gercekYorunge = loadSimpleScenario(argv[1]);
+            MuaseretScenarioOutput muaseretGirdileri = prepareMuaseretInputs(argv[1]);
+            plot3D(gercekYorunge, muaseretGirdileri);
+            return 0;
+        }
+        // Eksik argümanlı veya tanınmayan seçenekler varsayılan senaryoya düşmez
+        if (argc >= 2) {
+            throw std::invalid_argument(std::string("Gecersiz arguman '") + argv[1] + "'. " + usage);
+        }
         SearchableDataset gercekYorunge = createAndSaveSimpleScenario("SimpleScenario.csv");
         MuaseretScenarioOutput muaseretGirdileri = prepareMuaseretInputs("SimpleScenario.csv");
         plot3D(gercekYorunge, muaseretGirdileri);
@@ -0,0 +1,167 @@
+#include "SceneWorker.hpp"
+#include "Query.hpp"
+#include "Statistics.hpp"
+#include <chrono>
+
+SceneWorker::SceneWorker(const std::vector<SearchableDataset>& datasets, std::shared_mutex& datasets_mutex)
+    : datasets(datasets), datasets_mutex(datasets_mutex)
+{
+    target_animator.set_tracks(datasets);
+}
+
+void SceneWorker::start(std::function<void()> on_published) {
+    published = std::move(on_published);
+    stop_requested = false;
+    frame_thread = std::thread([this]() { frame_loop(); });
+    analysis_thread = std::thread([this]() { analysis_loop(); });
+}
+
+void SceneWorker::stop() {
+    stop_requested = true;
+    frame_signal.fetch_add(1);
+    frame_signal.notify_one();
+    {
+        std::lock_guard<std::mutex> lock(analysis_mutex);
+        analysis_wakeup.notify_one();
+    }
+    if (frame_thread.joinable()) frame_thread.join();
+    if (analysis_thread.joinable()) analysis_thread.join();
+}
+
+void SceneWorker::request_frame(double time, const std::vector<bool>& visibility) {
+    FrameRequest& request = frame_requests.back();
+    request.sequence = ++frame_sequence;
+    request.time = time;
+    request.visibility = visibility;
+    frame_requests.publish();
+    frame_signal.fetch_add(1, std::memory_order_release);
+    frame_signal.notify_one();
+}
+
+void SceneWorker::request_refresh(const std::vector<bool>& touched) {
+    std::lock_guard<std::mutex> lock(analysis_mutex);
+    pending_refresh.resize(std::max(pending_refresh.size(), touched.size()), false);
+    for (size_t i = 0; i < touched.size(); ++i) {
+        if (touched[i]) pending_refresh[i] = true;
+    }
+    refresh_requested = true;
+    analysis_busy = true;
+    analysis_wakeup.notify_one();
+}
+
+void SceneWorker::request_query(const std::string& text) {
+    std::lock_guard<std::mutex> lock(analysis_mutex);
+    pending_query = text;
+    query_requested = true;
+    analysis_busy = true;
+    analysis_wakeup.notify_one();
+}
+
+void SceneWorker::frame_loop() {
+    uint64_t seen = 0;
+    while (true) {
+        frame_signal.wait(seen, std::memory_order_acquire);
+        seen = frame_signal.load(std::memory_order_acquire);
+        if (stop_requested) return;
+        if (!frame_requests.acquire()) continue;
+
+        const FrameRequest& request = frame_requests.front();
+        {
+            std::shared_lock<std::shared_mutex> lock(datasets_mutex);
+            target_animator.update(datasets, request.visibility, request.time);
+        }
+        FrameSnapshot& snapshot = frame_results.back();
+        snapshot.request = request.sequence;
+        snapshot.time = request.time;
+        snapshot.target_matrices = target_animator.instance_matrices();
+        frame_results.publish();
+        if (published) published();
+    }
+}
+
+void SceneWorker::analysis_loop() {
+    while (true) {
+        std::vector<bool> touched;
+        std::string query_text;
+        bool do_refresh = false, do_query = false;
+        {
+            std::unique_lock<std::mutex> lock(analysis_mutex);
+            analysis_busy = refresh_requested || query_requested;
+            analysis_wakeup.wait(lock, [this]() { return stop_requested || refresh_requested || query_requested; });
+            if (stop_requested) return;
+            // Kuyruktaki istekler birleştirilir: tek bir yenileme ve en son sorgu çalıştırılır
+            if (refresh_requested) {
+                touched.swap(pending_refresh);
+                refresh_requested = false;
+                do_refresh = true;
+            }
+            if (query_requested) {
+                query_text.swap(pending_query);
+                query_requested = false;
+                do_query = true;
+            }
+        }
+        if (do_refresh) run_refresh(touched);
+        if (do_query) run_query(query_text);
+
+        analysis_results.back() = analysis_state;
+        analysis_results.publish();
+        {
+            std::lock_guard<std::mutex> lock(analysis_mutex);
+            analysis_busy = refresh_requested || query_requested;
+        }
+        if (published) published();
+    }
+}
+
+void SceneWorker::run_refresh(const std::vector<bool>& touched) {
+    auto pick_indices = std::make_shared<std::vector<std::pair<size_t, std::shared_ptr<const PointBVH>>>>();
+    auto column_stats = std::make_shared<std::vector<std::pair<size_t, std::vector<ColumnStats>>>>();
+    std::shared_lock<std::shared_mutex> lock(datasets_mutex);
+    for (size_t i = 0; i < touched.size() && i < datasets.size(); ++i) {
+        if (!touched[i]) continue;
+        auto bvh = std::make_shared<PointBVH>();
+        bvh->build(datasets[i].points);
+        pick_indices->push_back({ i, std::move(bvh) });
+        column_stats->push_back({ i, computeColumnStatistics(datasetColumns(datasets[i])) });
+    }
+    analysis_state.associations = std::make_shared<const std::vector<AssociationTable>>(buildAssociationTables(datasets));
+    analysis_state.pick_indices = std::move(pick_indices);
+    analysis_state.column_stats = std::move(column_stats);
+    analysis_state.refresh_generation++;
+}
+
+void SceneWorker::run_query(const std::string& text) {
+    analysis_state.query_generation++;
+    Query query;
+    std::string error;
+    if (!query.parse(text, error)) {
+        // Önceki sorgunun sonuçları geçerli kalır, yalnızca hata iletilir
+        analysis_state.query_message = std::string("Sorgu hatasi: ") + error;
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::shared_lock<std::shared_mutex> lock(datasets_mutex);
+    auto matches = std::make_shared<std::vector<std::vector<uint32_t>>>(datasets.size());
+    size_t total = 0, matched_datasets = 0;
+    std::string missing;
+    SelectionBitmap bitmap;
+    for (size_t i = 0; i < datasets.size(); ++i) {
+        // Sorgudaki bir sütunu olmayan veri setleri atlanır
+        if (!query.evaluate(datasets[i], bitmap, error)) {
+            if (missing.empty()) missing = error;
+            continue;
+        }
+        bitmap.indices((*matches)[i]);
+        total += (*matches)[i].size();
+        if (!(*matches)[i].empty()) matched_datasets++;
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), "%zu eslesme, %zu veri seti (%.1f ms)", total, matched_datasets, ms);
+    analysis_state.query_message = buffer;
+    if (!missing.empty()) analysis_state.query_message += " - " + missing;
+    analysis_state.query_columns = query.columns();
+    analysis_state.query_matches = std::move(matches);
+}
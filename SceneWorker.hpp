@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "DataStructures.hpp"
+#include "Association.hpp"
+#include "SpatialIndex.hpp"
+#include "TargetAnimation.hpp"
+#include "TripleBuffer.hpp"
+
+// Oynatma anındaki hedef konumları (kare başına istenen) için yayımlanan değişmez sonuç
+struct FrameSnapshot {
+    uint64_t request = 0;               // Karşılık gelen kare isteğinin sırası
+    double time = 0.0;
+    std::vector<float> target_matrices; // TargetAnimator::instance_matrices
+};
+
+// Ağır analizlerin birikimli sonuçları. Her iş türünün en son sonucu ve üretim numarası tutulur; okuyucu
+// numarası değişen sonuçları uygular. Büyük sonuçlar paylaşılan değişmez nesnelerdir, anlık görüntü kopyalanırken
+// veri kopyalanmaz.
+struct AnalysisSnapshot {
+    // Canlı veri yenilemesi: büyüyen veri setlerinin seçim indeksleri ve istatistikleri, tüm eşleşme tabloları
+    uint64_t refresh_generation = 0;
+    std::shared_ptr<const std::vector<AssociationTable>> associations;
+    std::shared_ptr<const std::vector<std::pair<size_t, std::shared_ptr<const PointBVH>>>> pick_indices;
+    std::shared_ptr<const std::vector<std::pair<size_t, std::vector<ColumnStats>>>> column_stats;
+
+    // Sütun sorgusu: veri seti başına eşleşen satırlar (artan sırada)
+    uint64_t query_generation = 0;
+    std::shared_ptr<const std::vector<std::vector<uint32_t>>> query_matches;
+    std::vector<std::string> query_columns;
+    std::string query_message;
+};
+
+// Veri üzerindeki kare başı ve ağır işleri ana (çizim) iş parçacığından ayırır.
+//  - Kare iş parçacığı: en son kare isteği için hedef enterpolasyonu yapar ve FrameSnapshot yayımlar.
+//  - Analiz iş parçacığı: canlı veri yenilemesi (BVH, istatistik, eşleşme) ve sorgu değerlendirmesi yapar ve
+//    AnalysisSnapshot yayımlar.
+// Sonuçlar üçlü tamponlarla yayımlanır; ana iş parçacığı acquire_* ile kilitsiz alır. Kare istekleri de ters yönde
+// bir üçlü tamponla iletilir (yalnızca en sonuncusu önemlidir); seyrek gelen analiz istekleri bir kuyrukta birikir.
+// İşler veri setlerini datasets_mutex'in paylaşımlı kilidiyle okur; veri setlerini değiştiren tek taraf olan ana
+// iş parçacığı eklemeleri bu kilidin özel hâlini alabildiğinde (try_lock) yapar, böylece ağır bir analiz sürerken
+// beklemez, eklemeler sonraki karelere kalır.
+class SceneWorker {
+public:
+    SceneWorker(const std::vector<SearchableDataset>& datasets, std::shared_mutex& datasets_mutex);
+    ~SceneWorker() { stop(); }
+
+    // published, bir sonuç yayımlandığında çalışma iş parçacığından çağrılır (örn. boşta bekleyen olay döngüsünü uyandırmak için)
+    void start(std::function<void()> published);
+    void stop();
+
+    // Ana iş parçacığı tarafı
+    void request_frame(double time, const std::vector<bool>& visibility);
+    bool acquire_frame() { return frame_results.acquire(); }
+    const FrameSnapshot& frame() const { return frame_results.front(); }
+
+    // touched veri setlerinin seçim indeksleri ve istatistikleri ile tüm eşleşme tabloları yeniden kurulur
+    void request_refresh(const std::vector<bool>& touched);
+    void request_query(const std::string& text);
+    bool analysis_pending() const { return analysis_busy; }
+    bool acquire_analysis() { return analysis_results.acquire(); }
+    const AnalysisSnapshot& analysis() const { return analysis_results.front(); }
+
+private:
+    struct FrameRequest {
+        uint64_t sequence = 0;
+        double time = 0.0;
+        std::vector<bool> visibility;
+    };
+
+    const std::vector<SearchableDataset>& datasets;
+    std::shared_mutex& datasets_mutex;
+    std::function<void()> published;
+
+    // Kare işleri
+    std::thread frame_thread;
+    TripleBuffer<FrameRequest> frame_requests;
+    TripleBuffer<FrameSnapshot> frame_results;
+    std::atomic<uint64_t> frame_signal{ 0 };
+    uint64_t frame_sequence = 0;
+    TargetAnimator target_animator;
+
+    // Analiz işleri
+    std::thread analysis_thread;
+    std::mutex analysis_mutex;
+    std::condition_variable analysis_wakeup;
+    std::vector<bool> pending_refresh;      // analysis_mutex ile korunur
+    bool refresh_requested = false;         // analysis_mutex ile korunur
+    std::string pending_query;              // analysis_mutex ile korunur
+    bool query_requested = false;           // analysis_mutex ile korunur
+    std::atomic<bool> analysis_busy{ false };
+    TripleBuffer<AnalysisSnapshot> analysis_results;
+    AnalysisSnapshot analysis_state;        // Yalnızca analiz iş parçacığı; her yayında back()'e kopyalanır
+
+    std::atomic<bool> stop_requested{ false };
+
+    void frame_loop();
+    void analysis_loop();
+    void run_refresh(const std::vector<bool>& touched);
+    void run_query(const std::string& text);
+};
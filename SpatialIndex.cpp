@@ -0,0 +1,134 @@
+#include "SpatialIndex.hpp"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+namespace {
+    // Işın ile küre arasındaki en küçük açısal eğimin (dik uzaklık / derinlik) alt sınırı.
+    // Küre ışını kesiyorsa 0, tamamen kameranın arkasındaysa sonsuz döner.
+    float min_slope_to_sphere(const Math::Vec3& origin, const Math::Vec3& dir, const Math::Vec3& center, float radius) {
+        Math::Vec3 v = { center.x - origin.x, center.y - origin.y, center.z - origin.z };
+        float t = v.x * dir.x + v.y * dir.y + v.z * dir.z;
+        if (t + radius <= 0.0f) return std::numeric_limits<float>::infinity();
+        float perp_sq = std::max(0.0f, v.x * v.x + v.y * v.y + v.z * v.z - t * t);
+        float perp = sqrtf(perp_sq);
+        if (perp <= radius) return 0.0f;
+        return (perp - radius) / (std::max(t, 0.0f) + radius);
+    }
+}
+
+void PointBVH::build(const std::vector<DataPoint>& points) {
+    nodes.clear();
+    point_indices.clear();
+    positions.clear();
+    if (points.empty()) return;
+
+    std::vector<Math::Vec3> gl_points(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        gl_points[i] = { (float)points[i].x, (float)points[i].z, (float)-points[i].y };
+    }
+    point_indices.resize(points.size());
+    std::iota(point_indices.begin(), point_indices.end(), 0u);
+    positions.swap(gl_points);
+
+    nodes.reserve(2 * (points.size() / leaf_size + 1));
+    nodes.push_back({});
+    build_node(0, 0, (uint32_t)points.size());
+
+    // Pozisyonları yaprak sırasına göre diz (sorgu sırasında bellek erişimi ardışık olsun)
+    std::vector<Math::Vec3> ordered(positions.size());
+    for (size_t i = 0; i < point_indices.size(); ++i) {
+        ordered[i] = positions[point_indices[i]];
+    }
+    positions.swap(ordered);
+}
+
+void PointBVH::build_node(uint32_t node_idx, uint32_t begin, uint32_t end) {
+    Math::Vec3 mn = positions[point_indices[begin]];
+    Math::Vec3 mx = mn;
+    for (uint32_t i = begin + 1; i < end; ++i) {
+        const auto& p = positions[point_indices[i]];
+        mn.x = std::min(mn.x, p.x); mn.y = std::min(mn.y, p.y); mn.z = std::min(mn.z, p.z);
+        mx.x = std::max(mx.x, p.x); mx.y = std::max(mx.y, p.y); mx.z = std::max(mx.z, p.z);
+    }
+    Math::Vec3 ext = { mx.x - mn.x, mx.y - mn.y, mx.z - mn.z };
+    nodes[node_idx].center = { (mn.x + mx.x) * 0.5f, (mn.y + mx.y) * 0.5f, (mn.z + mx.z) * 0.5f };
+    nodes[node_idx].radius = 0.5f * sqrtf(ext.x * ext.x + ext.y * ext.y + ext.z * ext.z);
+
+    if (end - begin <= leaf_size) {
+        nodes[node_idx].first = begin;
+        nodes[node_idx].count = end - begin;
+        return;
+    }
+
+    // En uzun eksende medyandan böl
+    int axis = (ext.x >= ext.y && ext.x >= ext.z) ? 0 : (ext.y >= ext.z ? 1 : 2);
+    auto coord = [&](uint32_t idx) {
+        const auto& p = positions[idx];
+        return axis == 0 ? p.x : (axis == 1 ? p.y : p.z);
+    };
+    uint32_t mid = begin + (end - begin) / 2;
+    std::nth_element(point_indices.begin() + begin, point_indices.begin() + mid, point_indices.begin() + end,
+        [&](uint32_t a, uint32_t b) { return coord(a) < coord(b); });
+
+    uint32_t left = (uint32_t)nodes.size();
+    nodes.push_back({});
+    nodes.push_back({});
+    nodes[node_idx].first = left;
+    nodes[node_idx].count = 0;
+    build_node(left, begin, mid);
+    build_node(left + 1, mid, end);
+}
+
+size_t PointBVH::pick(const PickQuery& query, float& max_dist_sq, const std::function<bool(size_t)>& accept) const {
+    if (nodes.empty()) return npos;
+
+    size_t best_idx = npos;
+    float best_dist_sq = max_dist_sq;
+    const Math::Vec3& o = query.ray_origin;
+    const Math::Vec3& d = query.ray_direction;
+
+    std::vector<uint32_t> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+
+        // Düğümün ekrandaki fareye olan uzaklığının alt sınırı mevcut en iyiden büyükse atla
+        float slope = min_slope_to_sphere(o, d, node.center, node.radius);
+        if (slope > query.pixel_slope * sqrtf(best_dist_sq)) continue;
+
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                Math::Vec3 screen;
+                if (!Math::project(positions[i], query.view_proj, query.viewport_width, query.viewport_height, screen)) continue;
+                float dx = query.mouse_x - screen.x;
+                float dy = query.mouse_y - screen.y;
+                float dist_sq = dx * dx + dy * dy;
+                if (dist_sq < best_dist_sq && (!accept || accept(point_indices[i]))) {
+                    best_dist_sq = dist_sq;
+                    best_idx = point_indices[i];
+                }
+            }
+        }
+        else {
+            // Işına daha yakın olan çocuk önce gezilsin diye yığına en son o eklenir
+            const Node& left = nodes[node.first];
+            const Node& right = nodes[node.first + 1];
+            float left_slope = min_slope_to_sphere(o, d, left.center, left.radius);
+            float right_slope = min_slope_to_sphere(o, d, right.center, right.radius);
+            if (left_slope < right_slope) {
+                stack.push_back(node.first + 1);
+                stack.push_back(node.first);
+            }
+            else {
+                stack.push_back(node.first);
+                stack.push_back(node.first + 1);
+            }
+        }
+    }
+
+    if (best_idx != npos) max_dist_sq = best_dist_sq;
+    return best_idx;
+}
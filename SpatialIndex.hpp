@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <functional>
+#include "DataStructures.hpp"
+#include "Math.hpp"
+
+// Ekran üzerinden nokta seçimi için kullanılan sorgu parametreleri.
+struct PickQuery {
+    Math::Vec3 ray_origin;
+    Math::Vec3 ray_direction;   // Birim vektör
+    Math::Mat4 view_proj;
+    int viewport_width = 0, viewport_height = 0;
+    float mouse_x = 0.0f, mouse_y = 0.0f; // Viewport'a göreli piksel koordinatları
+    float pixel_slope = 0.0f;   // Bir pikselin açısal karşılığı (tan), iki eksenin büyüğü
+};
+
+// Bir veri setinin noktaları üzerine kurulan sınırlayıcı hacim hiyerarşisi (BVH).
+// Tıklama ile seçimde tüm noktaları izdüşürmek yerine yalnızca ışın konisine değen düğümler gezilir.
+class PointBVH {
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    // Noktalar OpenGL koordinat sisteminde (x, z, -y) indekslenir.
+    void build(const std::vector<DataPoint>& points);
+    bool empty() const { return nodes.empty(); }
+
+    // Ekranda fareye max_dist_sq'dan daha yakın olan en yakın noktanın indeksini döndürür.
+    // Bulunursa max_dist_sq, bulunan noktanın piksel uzaklığının karesiyle güncellenir.
+    // accept verilirse yalnızca onu sağlayan noktalar (örn. zaman penceresi içindekiler) aday olur.
+    size_t pick(const PickQuery& query, float& max_dist_sq, const std::function<bool(size_t)>& accept = {}) const;
+
+private:
+    struct Node {
+        Math::Vec3 center;  // Sınırlayıcı kürenin merkezi
+        float radius;
+        uint32_t first;     // Yaprak: ilk nokta, iç düğüm: sol çocuk (sağ çocuk = first + 1)
+        uint32_t count;     // 0 ise iç düğüm
+    };
+
+    static constexpr uint32_t leaf_size = 16;
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> point_indices;   // Yapraklara göre sıralanmış orijinal indeksler
+    std::vector<Math::Vec3> positions;     // point_indices ile aynı sırada GL pozisyonları
+
+    void build_node(uint32_t node_idx, uint32_t begin, uint32_t end);
+};
@@ -0,0 +1,197 @@
+#include "Statistics.hpp"
+#include "Parallel.hpp"
+#include <cmath>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <iostream>
+
+namespace {
+    constexpr char sidecar_magic[8] = { 'A', 'D', 'S', 'T', 'A', 'T', '0', '2' };
+
+    void accumulate(ColumnStats& s, double v) {
+        if (std::isnan(v)) {
+            s.nan_count++;
+            return;
+        }
+        s.count++;
+        if (v < s.min) s.min = v;
+        if (v > s.max) s.max = v;
+        double delta = v - s.mean;
+        s.mean += delta / s.count;
+        s.m2 += delta * (v - s.mean);
+    }
+
+    // İki kısmi sonucu birleştirir (Chan ve ark. paralel varyans formülü)
+    void merge(ColumnStats& a, const ColumnStats& b) {
+        a.nan_count += b.nan_count;
+        if (b.count == 0) return;
+        if (a.count == 0) {
+            a.min = b.min; a.max = b.max; a.mean = b.mean; a.m2 = b.m2; a.count = b.count;
+            return;
+        }
+        size_t n = a.count + b.count;
+        double delta = b.mean - a.mean;
+        a.mean += delta * b.count / n;
+        a.m2 += b.m2 + delta * delta * ((double)a.count * b.count / n);
+        a.min = std::min(a.min, b.min);
+        a.max = std::max(a.max, b.max);
+        a.count = n;
+    }
+
+    std::string sidecar_path(const SearchableDataset& ds) {
+        std::string suffix = ds.name;
+        for (char& c : suffix) {
+            if (!std::isalnum((unsigned char)c)) c = '_';
+        }
+        return ds.source_path + "." + suffix + ".stats";
+    }
+
+    struct SourceKey {
+        uint64_t size = 0;
+        int64_t mtime = 0;
+        uint64_t rows = 0;
+        uint64_t processing = 0;    // Kayıttan çizim verisine dönüşümün girdileri (orijin, işleme sürümü)
+    };
+
+    bool source_key(const SearchableDataset& ds, uint64_t processing_key, SourceKey& key) {
+        std::error_code ec;
+        key.size = std::filesystem::file_size(ds.source_path, ec);
+        if (ec) return false;
+        key.mtime = (int64_t)std::filesystem::last_write_time(ds.source_path, ec).time_since_epoch().count();
+        if (ec) return false;
+        key.rows = ds.time_data.size();
+        key.processing = processing_key;
+        return true;
+    }
+
+    bool read_sidecar(const std::string& path, const SourceKey& key, std::vector<ColumnStats>& out) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open()) return false;
+        char magic[8];
+        SourceKey stored;
+        uint32_t column_count = 0;
+        in.read(magic, sizeof(magic));
+        in.read((char*)&stored, sizeof(stored));
+        in.read((char*)&column_count, sizeof(column_count));
+        if (!in || std::memcmp(magic, sidecar_magic, sizeof(magic)) != 0) return false;
+        if (stored.size != key.size || stored.mtime != key.mtime || stored.rows != key.rows || stored.processing != key.processing) return false;
+
+        std::vector<ColumnStats> result(column_count);
+        for (auto& s : result) {
+            uint32_t name_len = 0;
+            in.read((char*)&name_len, sizeof(name_len));
+            if (!in || name_len > 256) return false;
+            s.name.resize(name_len);
+            in.read(s.name.data(), name_len);
+            uint64_t count = 0, nan_count = 0;
+            in.read((char*)&s.min, sizeof(double));
+            in.read((char*)&s.max, sizeof(double));
+            in.read((char*)&s.mean, sizeof(double));
+            in.read((char*)&s.m2, sizeof(double));
+            in.read((char*)&count, sizeof(count));
+            in.read((char*)&nan_count, sizeof(nan_count));
+            s.count = count;
+            s.nan_count = nan_count;
+        }
+        if (!in) return false;
+        out.swap(result);
+        return true;
+    }
+
+    void write_sidecar(const std::string& path, const SourceKey& key, const std::vector<ColumnStats>& stats) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Istatistik onbellegi yazilamadi: " << path << std::endl;
+            return;
+        }
+        uint32_t column_count = (uint32_t)stats.size();
+        out.write(sidecar_magic, sizeof(sidecar_magic));
+        out.write((const char*)&key, sizeof(key));
+        out.write((const char*)&column_count, sizeof(column_count));
+        for (const auto& s : stats) {
+            uint32_t name_len = (uint32_t)s.name.size();
+            uint64_t count = s.count, nan_count = s.nan_count;
+            out.write((const char*)&name_len, sizeof(name_len));
+            out.write(s.name.data(), name_len);
+            out.write((const char*)&s.min, sizeof(double));
+            out.write((const char*)&s.max, sizeof(double));
+            out.write((const char*)&s.mean, sizeof(double));
+            out.write((const char*)&s.m2, sizeof(double));
+            out.write((const char*)&count, sizeof(count));
+            out.write((const char*)&nan_count, sizeof(nan_count));
+        }
+    }
+}
+
+std::vector<ColumnStats> computeColumnStatistics(const std::vector<ColumnView>& columns) {
+    size_t rows = 0;
+    for (const auto& col : columns) rows = std::max(rows, col.size);
+
+    // Her iş parçacığı bir satır bloğunun tüm sütunlarını işler, sonuçlar sonda birleştirilir.
+    size_t chunks = Parallel::chunk_count(rows, 1 << 16);
+    std::vector<std::vector<ColumnStats>> partial(std::max<size_t>(chunks, 1), std::vector<ColumnStats>(columns.size()));
+    Parallel::for_chunks(rows, 1 << 16, [&](size_t chunk, size_t begin, size_t end) {
+        for (size_t c = 0; c < columns.size(); ++c) {
+            const auto& col = columns[c];
+            ColumnStats& s = partial[chunk][c];
+            size_t col_end = std::min(end, col.size);
+            for (size_t i = begin; i < col_end; ++i) {
+                accumulate(s, col.data[i * col.stride]);
+            }
+        }
+    });
+
+    std::vector<ColumnStats> result(columns.size());
+    for (size_t c = 0; c < columns.size(); ++c) {
+        result[c].name = columns[c].name;
+        for (const auto& p : partial) merge(result[c], p[c]);
+    }
+    return result;
+}
+
+std::vector<ColumnView> datasetColumns(const SearchableDataset& ds) {
+    std::vector<ColumnView> columns;
+    auto add = [&columns](const char* name, const std::vector<double>& v) {
+        if (!v.empty()) columns.push_back({ name, v.data(), v.size(), 1 });
+    };
+    add("t", ds.time_data);
+    add("x", ds.x_data);
+    add("y", ds.y_data);
+    add("z", ds.z_data);
+    if (!ds.points.empty()) {
+        const size_t stride = sizeof(DataPoint) / sizeof(double);
+        columns.push_back({ "px", &ds.points[0].x, ds.points.size(), stride });
+        columns.push_back({ "py", &ds.points[0].y, ds.points.size(), stride });
+        columns.push_back({ "pz", &ds.points[0].z, ds.points.size(), stride });
+    }
+    add("range", ds.range_data);
+    add("bearing", ds.bearing_data);
+    add("elevation", ds.elevation_data);
+    return columns;
+}
+
+uint64_t statisticsProcessingKey(uint32_t version, std::initializer_list<double> inputs) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = (const unsigned char*)data;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    mix(&version, sizeof(version));
+    for (double v : inputs) mix(&v, sizeof(v));
+    return hash;
+}
+
+void loadOrComputeStatistics(SearchableDataset& ds, uint64_t processing_key) {
+    SourceKey key;
+    bool cacheable = !ds.source_path.empty() && source_key(ds, processing_key, key);
+    if (cacheable && read_sidecar(sidecar_path(ds), key, ds.column_stats)) return;
+
+    ds.column_stats = computeColumnStatistics(datasetColumns(ds));
+    if (cacheable) write_sidecar(sidecar_path(ds), key, ds.column_stats);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <initializer_list>
+#include "DataStructures.hpp"
+
+// İstatistiği hesaplanacak bir sütunun bellek görünümü. stride ile DataPoint gibi yapıların alanları da gösterilebilir.
+struct ColumnView {
+    std::string name;
+    const double* data = nullptr;
+    size_t size = 0;
+    size_t stride = 1;
+};
+
+// Tüm sütunların min/max/ortalama/varyans ve NaN sayılarını satır blokları üzerinde tek paralel geçişte hesaplar.
+std::vector<ColumnStats> computeColumnStatistics(const std::vector<ColumnView>& columns);
+
+// Veri setinde saklanan sütunların görünümleri: t, x, y, z (ECEF), px, py, pz (çizim), range, bearing, elevation
+std::vector<ColumnView> datasetColumns(const SearchableDataset& ds);
+
+// İstatistikleri kayıt dosyasının yanındaki önbellekten okur; önbellek yoksa veya kayıt değişmişse
+// hesaplayıp yeniden yazar. Kayıt dosyası olmayan veri setleri için yalnızca hesaplar.
+// Önbellekteki değerler dönüştürülmüş veriye aittir; processing_key dönüşümün girdilerini (orijin, işleme sürümü)
+// özetlemelidir ki kayıt aynı kalıp dönüşüm değiştiğinde eski istatistikler kullanılmasın (bkz. statisticsProcessingKey).
+void loadOrComputeStatistics(SearchableDataset& ds, uint64_t processing_key = 0);
+
+// Dönüşüm girdilerinden önbellek anahtarı (FNV-1a); version, dönüşüm kodu değiştiğinde artırılır
+uint64_t statisticsProcessingKey(uint32_t version, std::initializer_list<double> inputs);
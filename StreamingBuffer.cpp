@@ -0,0 +1,130 @@
+#include "StreamingBuffer.hpp"
+#include <algorithm>
+#include <cstring>
+
+// --- StreamRing ---
+void StreamRing::create(GLenum buffer_target, size_t region_bytes, size_t write_alignment) {
+    target = buffer_target;
+    alignment = std::max<size_t>(write_alignment, 1);
+    if (buffer == 0) glGenBuffers(1, &buffer);
+    allocate(region_bytes);
+}
+
+void StreamRing::destroy() {
+    for (auto& f : fences) {
+        if (f) glDeleteSync(f);
+        f = nullptr;
+    }
+    if (buffer) glDeleteBuffers(1, &buffer);
+    buffer = 0;
+    region_size = 0;
+}
+
+void StreamRing::allocate(size_t region_bytes) {
+    // Bölge boyutu hizalamanın katı olmalı ki her bölgenin başı bir köşe sınırına denk gelsin
+    region_size = (std::max<size_t>(region_bytes, alignment) + alignment - 1) / alignment * alignment;
+    for (auto& f : fences) {
+        if (f) glDeleteSync(f);
+        f = nullptr;
+    }
+    // Aynı ada yeni depolama: eski depolama hâlâ okunuyorsa sürücü onu arka planda serbest bırakır
+    glBindBuffer(target, buffer);
+    glBufferData(target, region_size * region_count, NULL, GL_STREAM_DRAW);
+    glBindBuffer(target, 0);
+}
+
+void StreamRing::wait_region(int region) {
+    if (!fences[region]) return;
+    // Bölge iki kare önce yazıldığından fence neredeyse her zaman geçilmiştir
+    GLenum status = glClientWaitSync(fences[region], GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    while (status == GL_TIMEOUT_EXPIRED) {
+        status = glClientWaitSync(fences[region], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+    }
+    glDeleteSync(fences[region]);
+    fences[region] = nullptr;
+}
+
+size_t StreamRing::write(const void* data, size_t bytes) {
+    if (bytes > region_size) {
+        allocate(std::max(bytes, region_size * 2));
+    }
+    current = (current + 1) % region_count;
+    wait_region(current);
+
+    size_t offset = current * region_size;
+    glBindBuffer(target, buffer);
+    void* dst = glMapBufferRange(target, offset, bytes,
+        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+    if (dst) {
+        memcpy(dst, data, bytes);
+        glUnmapBuffer(target);
+    }
+    else {
+        glBufferSubData(target, offset, bytes, data);
+    }
+    glBindBuffer(target, 0);
+    return offset;
+}
+
+void StreamRing::fence() {
+    if (fences[current]) glDeleteSync(fences[current]);
+    fences[current] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+
+// --- GrowableBuffer ---
+void GrowableBuffer::reserve(size_t bytes, GLenum buffer_usage) {
+    if (buffer != 0 && bytes <= capacity) return;
+    usage = buffer_usage;
+    GLuint new_buffer = 0;
+    glGenBuffers(1, &new_buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, new_buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, bytes, NULL, usage);
+    if (buffer != 0) {
+        if (used > 0) {
+            glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, used);
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &buffer);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    buffer = new_buffer;
+    capacity = bytes;
+}
+
+void GrowableBuffer::destroy() {
+    if (buffer) glDeleteBuffers(1, &buffer);
+    buffer = 0;
+    used = capacity = 0;
+}
+
+bool GrowableBuffer::grow_for(size_t bytes) {
+    if (buffer != 0 && used + bytes <= capacity) return false;
+    // İlk büyümeden sonra veri seti canlı kabul edilir ve tampon dinamik olarak işaretlenir
+    GLenum new_usage = buffer == 0 ? usage : GL_DYNAMIC_DRAW;
+    reserve(std::max(used + bytes, capacity * 2), new_usage);
+    return true;
+}
+
+bool GrowableBuffer::append(const void* data, size_t bytes) {
+    if (bytes == 0) return false;
+    bool recreated = grow_for(bytes);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, used, bytes, data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    used += bytes;
+    return recreated;
+}
+
+bool GrowableBuffer::append_copy(GLuint source, size_t source_offset, size_t bytes) {
+    if (bytes == 0) return false;
+    bool recreated = grow_for(bytes);
+    glBindBuffer(GL_COPY_READ_BUFFER, source);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, source_offset, used, bytes);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    used += bytes;
+    return recreated;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#define GLFW_INCLUDE_NONE
+#include <glad/glad.h>
+#include <cstddef>
+
+// Her karede yeniden yazılan küçük dinamik veriler (hata vektörleri vb.) için halka tampon.
+// Tek bir GL tamponu region_count bölgeye ayrılır; her yazma bir sonraki bölgeyi senkronizasyonsuz
+// eşleyerek doldurur. Bölge ancak onu okuyan çizimin fence'i geçildikten sonra tekrar yazılır,
+// böylece sürücü ne yeni bellek ayırır ne de GPU'yu bekletir.
+class StreamRing {
+public:
+    static constexpr int region_count = 3;
+
+    // alignment: yazma ofsetlerinin katı olacağı değer (köşe adımı), çizimde first = offset / alignment olur.
+    void create(GLenum target, size_t region_bytes, size_t alignment);
+    void destroy();
+
+    // Veriyi sıradaki bölgeye yazar ve tampon içindeki bayt ofsetini döndürür. Veri bölgeye sığmazsa
+    // tampon büyütülür (eski depolama terk edilir, fence'ler geçersizleşir).
+    size_t write(const void* data, size_t bytes);
+
+    // Son yazılan bölgeyi okuyan komutlar gönderildikten sonra çağrılır.
+    void fence();
+
+    GLuint id() const { return buffer; }
+
+private:
+    GLuint buffer = 0;
+    GLenum target = GL_ARRAY_BUFFER;
+    size_t region_size = 0;
+    size_t alignment = 1;
+    int current = region_count - 1;
+    GLsync fences[region_count] = {};
+
+    void allocate(size_t region_bytes);
+    void wait_region(int region);
+};
+
+// Yalnızca sonuna ekleme yapılan, kapasitesi iki katına çıkarak büyüyen tampon (büyüyen veri setleri için).
+// Büyüme sırasında eski içerik glCopyBufferSubData ile GPU üzerinde kopyalanır, CPU'dan yeniden yüklenmez.
+class GrowableBuffer {
+public:
+    void reserve(size_t bytes, GLenum usage = GL_STATIC_DRAW);
+    void destroy();
+
+    // Sonuna veri ekler. Tampon yeniden oluşturulduysa (adı değiştiyse) true döner; bu durumda
+    // tamponu kullanan VAO'ların öznitelikleri yeniden bağlanmalıdır.
+    bool append(const void* data, size_t bytes);
+    // Aynısı, verinin bir hazırlık (staging) tamponundan GPU üzerinde kopyalandığı sürümü.
+    bool append_copy(GLuint source, size_t source_offset, size_t bytes);
+
+    // Kullanılan boyutu küçültür; sonraki eklemeler bu ofsetten itibaren üzerine yazar.
+    void truncate(size_t bytes) { if (bytes < used) used = bytes; }
+
+    GLuint id() const { return buffer; }
+    size_t size() const { return used; }
+
+private:
+    GLuint buffer = 0;
+    size_t used = 0, capacity = 0;
+    GLenum usage = GL_STATIC_DRAW;
+
+    bool grow_for(size_t bytes);
+};
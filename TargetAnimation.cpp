@@ -0,0 +1,97 @@
+#include "TargetAnimation.hpp"
+#include "Association.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+
+void TargetAnimator::set_tracks(const std::vector<SearchableDataset>& datasets) {
+    tracks.clear();
+    for (size_t i = 0; i < datasets.size(); ++i) {
+        if (is_truth_dataset(datasets[i])) tracks.push_back({ i, 1 });
+    }
+}
+
+size_t TargetAnimator::advance_cursor(const double* times, size_t n, size_t cursor, double time) {
+    size_t last = n - 1;
+    cursor = std::clamp<size_t>(cursor, 1, last);
+    for (size_t step = 0; step < max_cursor_steps; ++step) {
+        if (cursor < last && times[cursor] < time) cursor++;
+        else if (cursor > 1 && times[cursor - 1] >= time) cursor--;
+        else return cursor;
+    }
+    // Büyük atlama: std::lower_bound ile aynı sonuç, [1, n-1] aralığına sınırlanmış
+    size_t idx = (size_t)(std::lower_bound(times, times + n, time) - times);
+    return std::clamp<size_t>(idx, 1, last);
+}
+
+void TargetAnimator::update(const std::vector<SearchableDataset>& datasets, const std::vector<bool>& visibility, double time) {
+    pos_x.clear(); pos_y.clear(); pos_z.clear();
+    dir_x.clear(); dir_y.clear(); dir_z.clear();
+
+    // Toplama: imleçleri ilerlet, segment uçlarından konumu ve yönü çıkar
+    for (auto& track : tracks) {
+        if (track.dataset_idx >= datasets.size()) continue;
+        if (track.dataset_idx < visibility.size() && !visibility[track.dataset_idx]) continue;
+        const auto& ds = datasets[track.dataset_idx];
+        size_t n = std::min(ds.points.size(), ds.time_data.size());
+        if (n < 2) continue;
+        const std::vector<double>& times = ds.time_data;
+        track.cursor = advance_cursor(times.data(), n, track.cursor, time);
+
+        size_t idx1 = track.cursor, idx0 = idx1 - 1;
+        const auto& p0 = ds.points[idx0];
+        const auto& p1 = ds.points[idx1];
+        double t0 = times[idx0], t1 = times[idx1];
+        double factor = (t1 - t0 > 1e-5) ? (time - t0) / (t1 - t0) : 0.0;
+        pos_x.push_back((float)(p0.x + (p1.x - p0.x) * factor));
+        pos_y.push_back((float)(p0.z + (p1.z - p0.z) * factor));
+        pos_z.push_back((float)-(p0.y + (p1.y - p0.y) * factor));
+
+        // Segment boyu sıfırsa (hedef duruyorsa) bir önceki segmentin yönü kullanılır
+        const DataPoint* a = &p0;
+        const DataPoint* b = &p1;
+        if (p1.x == p0.x && p1.y == p0.y && p1.z == p0.z && idx0 > 0) {
+            a = &ds.points[idx0 - 1];
+            b = &p0;
+        }
+        dir_x.push_back((float)(b->x - a->x));
+        dir_y.push_back((float)(b->z - a->z));
+        dir_z.push_back((float)-(b->y - a->y));
+    }
+
+    // Matrisler: modelin lokal -X ekseni (burnu) ileri yöne, +Y ekseni (üstü) yukarı yöne, +Z ekseni (sağ kanat)
+    // sağ yöne gider. Dejenere yönler (sıfır veya dikey) seçimle varsayılan eksenlere düşer.
+    size_t count = pos_x.size();
+    matrices.resize(count * 16);
+    Parallel::for_chunks(count, parallel_min_targets, [&](size_t, size_t begin, size_t end)
+    {
+        float* m = matrices.data();
+        for (size_t i = begin; i < end; ++i) {
+            float dx = dir_x[i], dy = dir_y[i], dz = dir_z[i];
+            float len = std::sqrt(dx * dx + dy * dy + dz * dz);
+            bool valid = len > 1e-5f;
+            float inv = valid ? 1.0f / len : 0.0f;
+            float fx = valid ? dx * inv : 1.0f;
+            float fy = dy * inv;
+            float fz = dz * inv;
+
+            // sağ = (0, 1, 0) x ileri
+            float right_len = std::sqrt(fx * fx + fz * fz);
+            bool right_valid = right_len > 1e-5f;
+            float right_inv = right_valid ? 1.0f / right_len : 0.0f;
+            float rx = fz * right_inv;
+            float rz = right_valid ? -fx * right_inv : 1.0f;
+
+            // yukarı = ileri x sağ
+            float ux = fy * rz;
+            float uy = fz * rx - fx * rz;
+            float uz = -fy * rx;
+
+            float* out = m + i * 16;
+            out[0] = -fx; out[1] = -fy; out[2] = -fz; out[3] = 0.0f;
+            out[4] = ux;  out[5] = uy;  out[6] = uz;  out[7] = 0.0f;
+            out[8] = rx;  out[9] = 0.0f; out[10] = rz; out[11] = 0.0f;
+            out[12] = pos_x[i]; out[13] = pos_y[i]; out[14] = pos_z[i]; out[15] = 1.0f;
+        }
+    });
+}
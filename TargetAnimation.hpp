@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include "DataStructures.hpp"
+
+// Gerçek (truth) veri setlerindeki hedeflerin oynatma anındaki konum ve yönelimleri.
+// Her hedef, bir önceki karede bulunduğu örneği gösteren bir imleç tutar; oynatma sırasında zaman az ilerlediği
+// için imleç birkaç adımda yerini bulur, ikili aramaya yalnızca büyük atlamalarda (sarma, kaydırıcı) dönülür.
+// İmleçlerden toplanan uç noktalar yapı-dizisi (SoA) olarak tutulur; enterpolasyon, yön normalizasyonu ve
+// matris kurulumu dallanmasız tek bir döngüde yapılır, böylece derleyici bunu vektörleştirebilir.
+class TargetAnimator {
+public:
+    // datasets içindeki gerçek veri setlerini hedef olarak seçer (imleçler sıfırlanır)
+    void set_tracks(const std::vector<SearchableDataset>& datasets);
+
+    // time anındaki model matrislerini hesaplar. Görünmeyen veya iki örnekten az verisi olan hedefler atlanır.
+    // Veri setleri büyüyebilir; imleçler her çağrıda mevcut boyuta göre sınırlanır.
+    void update(const std::vector<SearchableDataset>& datasets, const std::vector<bool>& visibility, double time);
+
+    // Hedef başına sütun öncelikli bir 4x4 model matrisi (16 float): önce döndürme, sonra konuma taşıma
+    const std::vector<float>& instance_matrices() const { return matrices; }
+    size_t instance_count() const { return matrices.size() / 16; }
+    size_t track_count() const { return tracks.size(); }
+
+private:
+    struct Track {
+        size_t dataset_idx;
+        size_t cursor = 1;  // time_data içinde time'dan küçük olmayan ilk örnek, [1, n-1] aralığında
+    };
+
+    // İmleç bu kadar adımda yerini bulamazsa ikili aramaya geçilir
+    static constexpr size_t max_cursor_steps = 16;
+    // Bu sayının üzerindeki hedefler için matris döngüsü iş parçacıklarına bölünür
+    static constexpr size_t parallel_min_targets = 16384;
+
+    std::vector<Track> tracks;
+    // Toplama adımının çıktısı: enterpolasyonlu konum ve normalize edilmemiş ileri yön (GL koordinatları)
+    std::vector<float> pos_x, pos_y, pos_z;
+    std::vector<float> dir_x, dir_y, dir_z;
+    std::vector<float> matrices;
+
+    static size_t advance_cursor(const double* times, size_t n, size_t cursor, double time);
+};
@@ -0,0 +1,118 @@
+#include "TimeSeries.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void MinMaxPyramid::clear() {
+    times.clear();
+    values.clear();
+    levels.clear();
+    source_count = 0;
+}
+
+void MinMaxPyramid::update(const std::vector<double>& source_times, const std::vector<double>& source_values) {
+    size_t n = std::min(source_times.size(), source_values.size());
+    if (n < source_count) clear();
+    if (n == source_count) return;
+
+    size_t dirty = times.size();    // Alt seviyede değişen ilk eleman
+    for (size_t i = source_count; i < n; ++i) {
+        if (std::isnan(source_values[i])) continue;
+        times.push_back(source_times[i]);
+        values.push_back((float)source_values[i]);
+    }
+    source_count = n;
+
+    // Her seviyede değişen ilk kovadan itibaren yeniden hesaplanır (son yarım kova ve yeni kovalar)
+    for (size_t k = 0;; ++k) {
+        size_t child_count = k == 0 ? times.size() : levels[k - 1].size();
+        if (child_count <= 1) {
+            levels.resize(k);
+            break;
+        }
+        if (levels.size() <= k) levels.emplace_back();
+        std::vector<Bucket>& level = levels[k];
+        size_t first_bucket = std::min(dirty / fan_out, level.size());
+        size_t bucket_count = (child_count + fan_out - 1) / fan_out;
+        level.resize(bucket_count);
+        for (size_t b = first_bucket; b < bucket_count; ++b) {
+            size_t begin = b * fan_out, end = std::min(begin + fan_out, child_count);
+            Bucket bucket;
+            if (k == 0) {
+                bucket = { times[begin], times[end - 1], values[begin], values[begin] };
+                for (size_t i = begin + 1; i < end; ++i) {
+                    bucket.min = std::min(bucket.min, values[i]);
+                    bucket.max = std::max(bucket.max, values[i]);
+                }
+            }
+            else {
+                const std::vector<Bucket>& children = levels[k - 1];
+                bucket = { children[begin].t_begin, children[end - 1].t_end, children[begin].min, children[begin].max };
+                for (size_t i = begin + 1; i < end; ++i) {
+                    bucket.min = std::min(bucket.min, children[i].min);
+                    bucket.max = std::max(bucket.max, children[i].max);
+                }
+            }
+            level[b] = bucket;
+        }
+        dirty = first_bucket;
+    }
+}
+
+void MinMaxPyramid::raw_range(double t0, double t1, size_t& begin, size_t& end) const {
+    begin = std::lower_bound(times.begin(), times.end(), t0) - times.begin();
+    end = std::upper_bound(times.begin(), times.end(), t1) - times.begin();
+    if (begin > 0) begin--;
+    if (end < times.size()) end++;
+}
+
+bool MinMaxPyramid::envelope(double t0, double t1, int width, std::vector<float>& col_min, std::vector<float>& col_max) const {
+    col_min.assign(std::max(width, 0), std::numeric_limits<float>::infinity());
+    col_max.assign(std::max(width, 0), -std::numeric_limits<float>::infinity());
+    if (times.empty() || width <= 0 || !(t1 > t0)) return true;
+
+    size_t begin = std::lower_bound(times.begin(), times.end(), t0) - times.begin();
+    size_t end = std::upper_bound(times.begin(), times.end(), t1) - times.begin();
+    if (end - begin < (size_t)width) return false;
+
+    double scale = width / (t1 - t0);
+    auto add = [&](double tb, double te, float mn, float mx) {
+        int c0 = std::clamp((int)((tb - t0) * scale), 0, width - 1);
+        int c1 = std::clamp((int)((te - t0) * scale), 0, width - 1);
+        for (int c = c0; c <= c1; ++c) {
+            col_min[c] = std::min(col_min[c], mn);
+            col_max[c] = std::max(col_max[c], mx);
+        }
+    };
+    auto add_raw = [&](size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) add(times[i], times[i], values[i], values[i]);
+    };
+
+    // Kova boyu sütun başına örnek sayısını aşmayan en kaba seviye
+    double samples_per_column = (double)(end - begin) / width;
+    int level = -1;
+    size_t span = 1;
+    while (level + 1 < (int)levels.size() && (double)(span * fan_out) <= samples_per_column) {
+        level++;
+        span *= fan_out;
+    }
+    if (level < 0) {
+        add_raw(begin, end);
+        return true;
+    }
+
+    // Aralığa tamamen giren kovalar [first, last); kenarlardaki artık örnekler ham olarak eklenir
+    size_t first = (begin + span - 1) / span;
+    size_t last = end / span;
+    if (first >= last) {
+        add_raw(begin, end);
+        return true;
+    }
+    add_raw(begin, first * span);
+    for (size_t b = first; b < last; ++b) {
+        const Bucket& bucket = levels[level][b];
+        add(bucket.t_begin, bucket.t_end, bucket.min, bucket.max);
+    }
+    add_raw(last * span, end);
+    return true;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+// Zaman serisi grafikleri için çok çözünürlüklü min/max piramidi.
+// k. seviyenin her kovası fan_out^(k+1) ardışık örneğin zaman aralığını ve değer zarfını tutar. Bir zaman aralığı
+// width piksel sütununa indirgenirken sütun başına örnek sayısını aşmayan en kaba seviye kullanılır; böylece
+// maliyet örnek sayısından değil sütun sayısından belirlenir ve saatlerce 100 Hz veri üzerinde kaydırma/yakınlaştırma
+// akıcı kalır. Kovalar sütunlara tam oturmadığından aralığın kenarlarındaki yarım kovalar ham örneklerden hesaplanır.
+// Örneklerin zamana göre sıralı olduğu varsayılır (kayıtlar zaman sırasındadır).
+class MinMaxPyramid {
+public:
+    static constexpr size_t fan_out = 8;
+
+    // Kaynağın son çağrıdan beri eklenen örneklerini ekler ve yalnızca etkilenen kovaları yeniden hesaplar.
+    // Kaynak kısaldıysa piramit baştan kurulur. NaN değerli örnekler atlanır.
+    void update(const std::vector<double>& times, const std::vector<double>& values);
+    size_t source_size() const { return source_count; }
+    bool empty() const { return times.empty(); }
+    void clear();
+
+    // [t0, t1] aralığını width sütuna indirger: col_min/col_max sütundaki örneklerin zarfıdır, örneği olmayan
+    // sütunlarda col_min > col_max kalır. Aralıktaki örnek sayısı sütun sayısından azsa false döner; bu durumda
+    // örnekler raw_range ile tek tek çizilmelidir.
+    bool envelope(double t0, double t1, int width, std::vector<float>& col_min, std::vector<float>& col_max) const;
+
+    // [t0, t1] aralığındaki örneklerin indeks aralığı, çizgiler kenarlara uzasın diye iki yanda birer örnek taşmalı
+    void raw_range(double t0, double t1, size_t& begin, size_t& end) const;
+    const std::vector<double>& sample_times() const { return times; }
+    const std::vector<float>& sample_values() const { return values; }
+
+private:
+    struct Bucket {
+        double t_begin, t_end;
+        float min, max;
+    };
+
+    std::vector<double> times;      // NaN olmayan örnekler
+    std::vector<float> values;
+    std::vector<std::vector<Bucket>> levels;
+    size_t source_count = 0;        // Kaynakta işlenmiş örnek sayısı (NaN'lar dahil)
+};
@@ -0,0 +1,174 @@
+#include "TrajectoryLod.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    float distance_sq_to_segment(const Math::Vec3& p, const Math::Vec3& a, const Math::Vec3& b) {
+        Math::Vec3 ab = { b.x - a.x, b.y - a.y, b.z - a.z };
+        Math::Vec3 ap = { p.x - a.x, p.y - a.y, p.z - a.z };
+        float len_sq = ab.x * ab.x + ab.y * ab.y + ab.z * ab.z;
+        float t = len_sq > 0.0f ? std::clamp((ap.x * ab.x + ap.y * ab.y + ap.z * ab.z) / len_sq, 0.0f, 1.0f) : 0.0f;
+        Math::Vec3 d = { ap.x - ab.x * t, ap.y - ab.y * t, ap.z - ab.z * t };
+        return d.x * d.x + d.y * d.y + d.z * d.z;
+    }
+
+    // [begin, end] aralığını Douglas-Peucker ile seyreltir, tutulan indeksleri sıralı döndürür (uçlar her zaman tutulur).
+    std::vector<uint32_t> douglas_peucker(const std::vector<Math::Vec3>& v, uint32_t begin, uint32_t end, float tolerance) {
+        std::vector<uint8_t> keep(end - begin + 1, 0);
+        keep.front() = keep.back() = 1;
+        float tol_sq = tolerance * tolerance;
+        std::vector<std::pair<uint32_t, uint32_t>> stack = { { begin, end } };
+        while (!stack.empty()) {
+            auto [a, b] = stack.back();
+            stack.pop_back();
+            if (b <= a + 1) continue;
+            float max_dist_sq = -1.0f;
+            uint32_t max_idx = a;
+            for (uint32_t i = a + 1; i < b; ++i) {
+                float d = distance_sq_to_segment(v[i], v[a], v[b]);
+                if (d > max_dist_sq) { max_dist_sq = d; max_idx = i; }
+            }
+            if (max_dist_sq > tol_sq) {
+                keep[max_idx - begin] = 1;
+                stack.push_back({ a, max_idx });
+                stack.push_back({ max_idx, b });
+            }
+        }
+        std::vector<uint32_t> kept;
+        for (uint32_t i = begin; i <= end; ++i) {
+            if (keep[i - begin]) kept.push_back(i);
+        }
+        return kept;
+    }
+}
+
+void TrajectoryLod::select_ranges(const Math::Vec3& eye, float pixels_per_unit_at_1m, float max_error_px,
+    const Frustum& frustum, float t_start, float t_end,
+    std::vector<int>& base_firsts, std::vector<int>& base_counts,
+    std::vector<int>& coarse_firsts, std::vector<int>& coarse_counts) const {
+    for (const auto& chunk : chunks) {
+        if (!chunk.bounds.visible(frustum, t_start, t_end)) continue;
+        float dx = chunk.center.x - eye.x, dy = chunk.center.y - eye.y, dz = chunk.center.z - eye.z;
+        float dist = std::max(1.0f, sqrtf(dx * dx + dy * dy + dz * dz) - chunk.radius);
+        // Ekran uzayı hatası izin verilen sınırın altında kalan en kaba seviyeyi seç
+        size_t level = 0;
+        for (size_t l = chunk.levels.size(); l-- > 1;) {
+            if (chunk.tolerance[l] * pixels_per_unit_at_1m / dist <= max_error_px) {
+                level = l;
+                break;
+            }
+        }
+        const LodRange& range = chunk.levels[level];
+        if (level == 0 && !base_firsts.empty() && base_firsts.back() + base_counts.back() - 1 == (int)range.first) {
+            // Komşu tam çözünürlüklü parçalar uç noktayı paylaştığından tek şerit olarak çizilebilir
+            base_counts.back() += (int)range.count - 1;
+            continue;
+        }
+        auto& firsts = level == 0 ? base_firsts : coarse_firsts;
+        auto& counts = level == 0 ? base_counts : coarse_counts;
+        firsts.push_back((int)range.first);
+        counts.push_back((int)range.count);
+    }
+}
+
+size_t TrajectoryLod::append(const std::vector<DataPoint>& points, const std::vector<double>& times) {
+    size_t new_count = points.size();
+    if (new_count < point_count || (new_count == point_count && !chunks.empty())) return coarse_vertices.size();
+    point_count = new_count;
+    if (new_count < 2) return coarse_vertices.size();
+
+    // Son parça yarımsa kaba seviyeleri atılır ve yeni noktalarla birlikte yeniden üretilir.
+    // Kaba köşeleri her zaman en sonda olduğundan kesmek, önceki parçaları etkilemez.
+    const size_t last = new_count - 1;
+    size_t first_chunk = chunks.size();
+    if (!chunks.empty()) {
+        const auto& tail = chunks.back();
+        size_t tail_end = tail.levels[0].first + tail.levels[0].count - 1;
+        if (tail_end < chunks.size() * chunk_size) {
+            first_chunk = chunks.size() - 1;
+            if (tail.levels.size() > 1) {
+                size_t cut = tail.levels[1].first;
+                coarse_vertices.resize(cut);
+                coarse_source_index.resize(cut);
+            }
+        }
+    }
+    size_t dirty_from = coarse_vertices.size();
+    const size_t chunk_count = (last + chunk_size - 1) / chunk_size;
+    if (first_chunk >= chunk_count) return dirty_from;
+    chunks.resize(chunk_count);
+
+    // Yalnızca yeniden hesaplanacak parçaların noktaları GL koordinatlarına çevrilir
+    const size_t base = first_chunk * chunk_size;
+    std::vector<Math::Vec3> vertices(new_count - base);
+    for (size_t i = base; i < new_count; ++i) {
+        vertices[i - base] = { (float)points[i].x, (float)points[i].z, (float)-points[i].y };
+    }
+
+    // Parça sınırları: [k*C, (k+1)*C] (komşu parçalar bir köşeyi paylaşır)
+    const bool has_time = times.size() >= new_count;
+    std::vector<std::vector<std::vector<uint32_t>>> coarse(chunk_count - first_chunk);
+    Parallel::for_chunks(chunk_count - first_chunk, 4, [&](size_t, size_t chunk_begin, size_t chunk_end) {
+        for (size_t k = chunk_begin; k < chunk_end; ++k) {
+            size_t c = first_chunk + k;
+            uint32_t begin = (uint32_t)(c * chunk_size - base);
+            uint32_t end = (uint32_t)(std::min(last, (c + 1) * chunk_size) - base);
+            auto& chunk = chunks[c];
+
+            Math::Vec3 cmn = vertices[begin], cmx = vertices[begin];
+            for (uint32_t i = begin; i <= end; ++i) {
+                const auto& v = vertices[i];
+                cmn.x = std::min(cmn.x, v.x); cmn.y = std::min(cmn.y, v.y); cmn.z = std::min(cmn.z, v.z);
+                cmx.x = std::max(cmx.x, v.x); cmx.y = std::max(cmx.y, v.y); cmx.z = std::max(cmx.z, v.z);
+            }
+            chunk.center = { (cmn.x + cmx.x) * 0.5f, (cmn.y + cmx.y) * 0.5f, (cmn.z + cmx.z) * 0.5f };
+            chunk.radius = 0.5f * sqrtf((cmx.x - cmn.x) * (cmx.x - cmn.x) + (cmx.y - cmn.y) * (cmx.y - cmn.y) + (cmx.z - cmn.z) * (cmx.z - cmn.z));
+            chunk.bounds = ChunkBounds{};
+            chunk.bounds.box.min = cmn;
+            chunk.bounds.box.max = cmx;
+            if (has_time) {
+                auto [t_min, t_max] = std::minmax_element(times.begin() + base + begin, times.begin() + base + end + 1);
+                chunk.bounds.t_min = (float)*t_min;
+                chunk.bounds.t_max = (float)*t_max;
+            }
+            chunk.levels.assign(1, { (uint32_t)(begin + base), end - begin + 1 });
+            chunk.tolerance.assign(1, 0.0f);
+
+            // Seviye toleransları parçanın boyutuna göre: her seviye bir öncekinin 4 katı sapmaya izin verir
+            size_t prev_count = end - begin + 1;
+            for (int l = 1; l < max_levels; ++l) {
+                float tolerance = 2.0f * chunk.radius * 1e-4f * std::pow(4.0f, (float)(l - 1));
+                auto kept = douglas_peucker(vertices, begin, end, tolerance);
+                // Bir önceki seviyeye göre kazanç yoksa daha kaba seviye üretme
+                if (kept.size() >= prev_count) break;
+                prev_count = kept.size();
+                chunk.tolerance.push_back(tolerance);
+                coarse[k].push_back(std::move(kept));
+                if (prev_count <= 2) break;
+            }
+        }
+    });
+
+    // Kaba seviyeleri sırayla coarse_vertices'in sonuna ekle
+    for (size_t k = 0; k < coarse.size(); ++k) {
+        auto& chunk = chunks[first_chunk + k];
+        for (const auto& kept : coarse[k]) {
+            chunk.levels.push_back({ (uint32_t)coarse_vertices.size(), (uint32_t)kept.size() });
+            for (uint32_t idx : kept) {
+                coarse_vertices.push_back(vertices[idx]);
+                coarse_source_index.push_back((uint32_t)(idx + base));
+            }
+        }
+    }
+    return dirty_from;
+}
+
+TrajectoryLod buildTrajectoryLod(const std::vector<DataPoint>& points, const std::vector<double>& times,
+    size_t chunk_size, int max_levels) {
+    TrajectoryLod lod;
+    lod.chunk_size = chunk_size;
+    lod.max_levels = max_levels;
+    lod.append(points, times);
+    return lod;
+}
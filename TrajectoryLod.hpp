@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "DataStructures.hpp"
+#include "Math.hpp"
+#include "Culling.hpp"
+
+// Bir yörünge parçasının (chunk) bir detay seviyesindeki köşe aralığı (GL_LINE_STRIP olarak çizilir).
+struct LodRange {
+    uint32_t first = 0;
+    uint32_t count = 0;
+};
+
+// Ardışık örneklerden oluşan yörünge parçası. Komşu parçalar bir uç noktayı paylaşır, böylece
+// farklı seviyelerde çizilseler de çizgi kesintisiz kalır.
+struct TrajectoryChunk {
+    Math::Vec3 center = { 0, 0, 0 }; // Sınırlayıcı küre (ekran uzayı hatası için)
+    float radius = 0.0f;
+    std::vector<LodRange> levels;    // levels[0]: nokta indeksleri, diğerleri coarse_vertices içinde
+    std::vector<float> tolerance;    // Her seviyenin dünya uzayındaki en büyük sapması (m)
+    ChunkBounds bounds;              // Görüş piramidi ve zaman penceresi ile kırpma için
+};
+
+// Douglas-Peucker ile seyreltilmiş çok çözünürlüklü yörünge piramidi.
+// 0. seviye orijinal noktaların kendisidir (köşe indeksi = nokta indeksi) ve ayrı bir tamponda tutulur;
+// kaba seviyelerin köşeleri coarse_vertices'te yer alır ve coarse_source_index ile orijinal noktaya eşlenir.
+// İki tampon da yalnızca sonuna ekleme ile büyüdüğünden yeni örnekler mevcut veriyi yeniden yüklemeden eklenir.
+struct TrajectoryLod {
+    std::vector<Math::Vec3> coarse_vertices;    // OpenGL koordinatları (x, z, -y)
+    std::vector<uint32_t> coarse_source_index;  // coarse_vertices[i] -> orijinal nokta indeksi
+    std::vector<TrajectoryChunk> chunks;
+    size_t point_count = 0;
+    size_t chunk_size = 4096;
+    int max_levels = 8;
+
+    // Nokta dizisi büyüdükten sonra çağrılır: son (yarım) parça yeniden hesaplanır, yeni parçalar eklenir.
+    // Dönüş: coarse_vertices'te değişen ilk köşe; bu indeksten sonrası GPU'ya yeniden yüklenmelidir.
+    // times noktalarla aynı boydaysa parçaların zaman aralıkları da tutulur.
+    size_t append(const std::vector<DataPoint>& points, const std::vector<double>& times = {});
+
+    // Görüş piramidi ve [t_start, t_end] ile kesişen parçaların, kamera uzaklığına göre seçilmiş seviyedeki
+    // çizim aralıklarını ekler; 0. seviyedeki parçalar base_* (ardışık olanlar birleştirilerek), kaba
+    // seviyedekiler coarse_* listelerine yazılır.
+    // pixels_per_unit_at_1m: 1 m uzaklıktaki 1 m'lik uzunluğun piksel karşılığı, max_error_px: izin verilen hata.
+    void select_ranges(const Math::Vec3& eye, float pixels_per_unit_at_1m, float max_error_px,
+        const Frustum& frustum, float t_start, float t_end,
+        std::vector<int>& base_firsts, std::vector<int>& base_counts,
+        std::vector<int>& coarse_firsts, std::vector<int>& coarse_counts) const;
+};
+
+TrajectoryLod buildTrajectoryLod(const std::vector<DataPoint>& points, const std::vector<double>& times = {},
+    size_t chunk_size = 4096, int max_levels = 8);
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+// Tek yazıcılı, tek okuyuculu üçlü tampon. Yazıcı back() tamponunu doldurup publish ile ortadaki tamponla atomik
+// olarak yer değiştirir; okuyucu acquire ile yeni yayımlanmış ortadaki tamponu kendi ön tamponuyla değiştirir.
+// İki taraf da hiçbir zaman beklemez ve kilit kullanılmaz. Okuyucu her zaman yayımlanmış en son değeri görür;
+// arada yayımlananlar atlanabilir, bu yüzden değerler birikimli (son durumun tamamı) olmalıdır.
+// Tamponlar yeniden kullanıldığından yazıcı back()'i her seferinde baştan doldurmalıdır.
+template <typename T>
+class TripleBuffer {
+public:
+    // Yazıcı tarafı
+    T& back() { return slots[back_idx]; }
+    void publish() {
+        back_idx = middle.exchange(back_idx | fresh_bit, std::memory_order_acq_rel) & index_mask;
+    }
+
+    // Okuyucu tarafı: yeni bir değer yayımlandıysa ön tampona alır ve true döner
+    bool acquire() {
+        if (!(middle.load(std::memory_order_acquire) & fresh_bit)) return false;
+        front_idx = middle.exchange(front_idx, std::memory_order_acq_rel) & index_mask;
+        return true;
+    }
+    const T& front() const { return slots[front_idx]; }
+
+private:
+    static constexpr unsigned fresh_bit = 4, index_mask = 3;
+
+    std::array<T, 3> slots;
+    unsigned back_idx = 0, front_idx = 1;   // Yalnızca sahibi olan taraf kullanır
+    std::atomic<unsigned> middle{ 2 };      // Ortadaki tampon ve yeni değer biti
+};
@@ -0,0 +1,41 @@
+#include "VertexQuantizer.hpp"
+#include <cmath>
+
+bool VertexQuantizer::append(const Math::Vec3* vertices, size_t count, std::vector<QuantizedVertex>& out) {
+    const float scale = extent / 32767.0f;
+    const float inv_scale = 1.0f / scale;
+    out.reserve(out.size() + count);
+    for (size_t i = 0; i < count; ++i) {
+        const Math::Vec3& v = vertices[i];
+        int found = -1;
+        for (size_t r = 0; r < recent_size && found < 0; ++r) {
+            const QuantChunk& c = table[recent[r]];
+            if (fabsf(v.x - c.cx) <= extent && fabsf(v.y - c.cy) <= extent && fabsf(v.z - c.cz) <= extent) {
+                found = (int)r;
+            }
+        }
+
+        uint16_t chunk_idx;
+        if (found >= 0) {
+            chunk_idx = recent[found];
+            // Bulunan parçayı en öne taşı
+            for (int r = found; r > 0; --r) recent[r] = recent[r - 1];
+        }
+        else {
+            if (table.size() >= max_chunks) return false;
+            chunk_idx = (uint16_t)table.size();
+            table.push_back({ v.x, v.y, v.z, scale });
+            if (recent_size < recent_count) recent_size++;
+            for (size_t r = recent_size - 1; r > 0; --r) recent[r] = recent[r - 1];
+        }
+        recent[0] = chunk_idx;
+
+        const QuantChunk& c = table[chunk_idx];
+        out.push_back({
+            (int16_t)lrintf((v.x - c.cx) * inv_scale),
+            (int16_t)lrintf((v.y - c.cy) * inv_scale),
+            (int16_t)lrintf((v.z - c.cz) * inv_scale),
+            chunk_idx });
+    }
+    return true;
+}
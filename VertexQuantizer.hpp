@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Math.hpp"
+
+// 8 baytlık sıkıştırılmış köşe: parça merkezine göre int16 konum + parça numarası.
+// Renk köşede tutulmaz, veri seti başına uniform olarak verilir.
+struct QuantizedVertex {
+    int16_t x, y, z;
+    uint16_t chunk;
+};
+
+// Parça tablosunun bir elemanı; GPU'da RGBA32F doku tamponunda bir texel'e karşılık gelir.
+struct QuantChunk {
+    float cx, cy, cz;   // Parça merkezi (GL koordinatları)
+    float scale;        // int16 biriminin metre karşılığı
+};
+
+// Köşeleri, merkezinden en fazla max_extent uzaklıktaki noktaları kapsayan küp parçalara ayırarak sıkıştırır.
+// Parçalar oluşturulduktan sonra değişmez, bu yüzden yeni köşeler önceki köşelere dokunmadan eklenebilir.
+class VertexQuantizer {
+public:
+    static constexpr size_t max_chunks = 65536;
+
+    explicit VertexQuantizer(float max_extent = 2048.0f) : extent(max_extent) {}
+
+    // Köşeleri sıkıştırıp out'un sonuna ekler. Parça tablosu taşarsa false döner; bu durumda
+    // daha büyük max_extent ile yeni bir sıkıştırıcı kurulup tüm veri yeniden sıkıştırılmalıdır.
+    bool append(const Math::Vec3* vertices, size_t count, std::vector<QuantizedVertex>& out);
+
+    const std::vector<QuantChunk>& chunks() const { return table; }
+    float max_extent() const { return extent; }
+
+private:
+    float extent;
+    std::vector<QuantChunk> table;
+
+    // Dağınık nokta bulutlarında (ör. birden çok hedefe ait sıralı ölçümler) her sıçramada yeni parça
+    // açılmasın diye son kullanılan birkaç parça da denenir.
+    static constexpr size_t recent_count = 8;
+    uint16_t recent[recent_count] = {};
+    size_t recent_size = 0;
+};